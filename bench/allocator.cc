@@ -0,0 +1,104 @@
+// Benchmark of Delta construction and destruction with the default allocator and with memory resources (arena, pool),
+//  counting the calls of the global operator new.
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <random>
+
+#include "bench.hh"
+#include "mata/nfa/delta.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+size_t num_of_allocations{ 0 };
+
+void* allocate(const size_t size, const size_t alignment = alignof(std::max_align_t)) {
+    ++num_of_allocations;
+    void* pointer{ alignment <= alignof(std::max_align_t)
+                       ? std::malloc(size)
+                       : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment) };
+    if (pointer == nullptr) { throw std::bad_alloc{}; }
+    return pointer;
+}
+
+} // namespace.
+
+void* operator new(const size_t size) { return allocate(size); }
+void* operator new[](const size_t size) { return allocate(size); }
+void* operator new(const size_t size, const std::align_val_t alignment) {
+    return allocate(size, static_cast<size_t>(alignment));
+}
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { std::free(pointer); }
+
+namespace {
+
+struct Transition {
+    State source;
+    Symbol symbol;
+    State target;
+};
+
+std::vector<Transition> random_transitions(const size_t num_of_states, const size_t num_of_transitions) {
+    std::mt19937_64 random{ 42 };
+    std::vector<Transition> transitions(num_of_transitions);
+    for (Transition& transition : transitions) {
+        transition = { random() % num_of_states, 'a' + static_cast<Symbol>(random() % 16), random() % num_of_states };
+    }
+    return transitions;
+}
+
+/// Build a delta into @p resource and destroy it, reporting the time and the number of global allocations.
+void bench_build(const std::string& name, const std::vector<Transition>& transitions, const size_t num_of_states,
+                 std::pmr::memory_resource* resource, const std::function<void()>& release = [] {}) {
+    const size_t allocations_before{ num_of_allocations };
+    double teardown_seconds{ 0 };
+    const double seconds{ bench::measure([&] {
+        auto* delta{ new Delta{ num_of_states, resource } };
+        for (const Transition& transition : transitions) {
+            delta->add(transition.source, transition.symbol, transition.target);
+        }
+        bench::do_not_optimize(delta);
+        teardown_seconds = bench::measure([&] {
+            delete delta;
+            release();
+        });
+    }) };
+    const size_t allocations{ num_of_allocations - allocations_before };
+    const std::string case_name{ name + ", " + std::to_string(num_of_states) + " states" };
+    bench::report("Delta build+destroy, " + case_name, seconds, transitions.size());
+    bench::report("Delta destroy, " + case_name, teardown_seconds, transitions.size());
+    std::printf("%-64s %12zu allocations\n", ("Delta allocations, " + case_name).c_str(), allocations);
+}
+
+void bench_resources(const size_t num_of_states, const size_t num_of_transitions) {
+    const std::vector<Transition> transitions{ random_transitions(num_of_states, num_of_transitions) };
+
+    bench_build("default", transitions, num_of_states, std::pmr::get_default_resource());
+
+    std::pmr::monotonic_buffer_resource arena{};
+    bench_build("arena", transitions, num_of_states, &arena, [&] { arena.release(); });
+
+    std::pmr::unsynchronized_pool_resource pool{};
+    bench_build("pool", transitions, num_of_states, &pool, [&] { pool.release(); });
+}
+
+} // namespace.
+
+int main() {
+    // 1000000 transitions of a dense automaton (tens of targets per state) and of a sparse automaton (one or two
+    //  targets per state).
+    bench_resources(10000, 1000000);
+    bench_resources(500000, 1000000);
+    return 0;
+}
@@ -0,0 +1,119 @@
+// Small helpers shared by the benchmarks.
+//
+// Every reported result is also recorded; if the environment variable BENCH_JSON names a file, the results are written
+//  there as JSON when the benchmark exits, so that runs of alternative designs can be compared.
+
+#ifndef BENCH_HH
+#define BENCH_HH
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+/// Prevent the compiler from optimizing away the computation of @p value.
+template<class T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// Run @p function once and return the elapsed time in seconds.
+template<class Function>
+double measure(Function&& function) {
+    const auto start{ std::chrono::steady_clock::now() };
+    function();
+    const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+    return elapsed.count();
+}
+
+/// Named numeric parameters of a benchmark case (automaton size, density, ...), recorded in the JSON output.
+using Parameters = std::vector<std::pair<std::string, double>>;
+
+/// Results of the benchmark cases run so far, written as JSON to the file named by BENCH_JSON at exit.
+class Results {
+public:
+    static Results& get() {
+        static Results results{};
+        return results;
+    }
+
+    void add(const std::string& name, const double seconds, const size_t num_of_operations,
+             const std::optional<double> megabytes_per_second, const Parameters& parameters) {
+        std::ostringstream record{};
+        record << std::setprecision(9) << "    {\"name\": " << quote(name) << ", \"seconds\": " << seconds
+               << ", \"operations\": " << num_of_operations
+               << ", \"ns_per_op\": " << seconds * 1e9 / static_cast<double>(num_of_operations);
+        if (megabytes_per_second) { record << ", \"mb_per_s\": " << *megabytes_per_second; }
+        record << ", \"parameters\": {";
+        for (size_t i{ 0 }; i < parameters.size(); ++i) {
+            record << (i == 0 ? "" : ", ") << quote(parameters[i].first) << ": " << parameters[i].second;
+        }
+        record << "}}";
+        records_.push_back(record.str());
+    }
+
+    ~Results() {
+        const char* const path{ std::getenv("BENCH_JSON") };
+        if (path == nullptr) { return; }
+        std::FILE* const file{ std::fopen(path, "w") };
+        if (file == nullptr) { std::perror(path); return; }
+        std::fprintf(file, "{\n  \"results\": [\n");
+        for (size_t i{ 0 }; i < records_.size(); ++i) {
+            std::fprintf(file, "%s%s\n", records_[i].c_str(), i + 1 < records_.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+        std::fclose(file);
+    }
+
+private:
+    Results() = default;
+
+    static std::string quote(const std::string& text) {
+        std::string quoted{ "\"" };
+        for (const char c : text) {
+            if (c == '"' || c == '\\') { quoted += '\\'; }
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    std::vector<std::string> records_{};
+};
+
+/// Print the time per operation of a benchmark which executed @p num_of_operations operations in @p seconds.
+inline void report(const std::string& name, const double seconds, const size_t num_of_operations,
+                   const Parameters& parameters = {}) {
+    std::printf("%-64s %12.2f ns/op %12.3f ms total\n", name.c_str(),
+                seconds * 1e9 / static_cast<double>(num_of_operations), seconds * 1e3);
+    Results::get().add(name, seconds, num_of_operations, std::nullopt, parameters);
+}
+
+/// Print the throughput of a benchmark which processed @p num_of_bytes bytes in @p seconds.
+inline void report_throughput(const std::string& name, const double seconds, const size_t num_of_bytes,
+                              const Parameters& parameters = {}) {
+    const double megabytes_per_second{ static_cast<double>(num_of_bytes) / seconds / 1e6 };
+    std::printf("%-64s %12.4g MB/s %13.3f ms total\n", name.c_str(), megabytes_per_second, seconds * 1e3);
+    Results::get().add(name, seconds, num_of_bytes, megabytes_per_second, parameters);
+}
+
+/// Values of a benchmark parameter: the comma-separated list in the environment variable @p variable if it is set,
+///  @p defaults otherwise.
+inline std::vector<size_t> parameter_values(const char* const variable, std::vector<size_t> defaults) {
+    const char* const list{ std::getenv(variable) };
+    if (list == nullptr || *list == '\0') { return defaults; }
+    std::vector<size_t> values{};
+    std::istringstream stream{ list };
+    for (std::string value; std::getline(stream, value, ',');) { values.push_back(std::stoul(value)); }
+    return values;
+}
+
+} // namespace bench.
+
+#endif // BENCH_HH
@@ -0,0 +1,69 @@
+// Benchmark of the bit-parallel simulation of small automata against the set-based simulation over FrozenDelta.
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include "bench.hh"
+#include "mata/nfa/nfa.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+/// Pattern search automaton: a self-loop over all bytes in the initial state followed by a chain of random letters.
+Nfa chain_nfa(const size_t num_of_states) {
+    std::mt19937_64 random{ 42 };
+    Delta delta{ num_of_states };
+    for (Symbol symbol{ 1 }; symbol < 256; ++symbol) { delta.add(0, symbol, 0); }
+    for (State state{ 0 }; state + 1 < num_of_states; ++state) {
+        delta.add(state, 'a' + static_cast<Symbol>(random() % 4), state + 1);
+    }
+    return Nfa{ std::move(delta), { 0 }, { num_of_states - 1 }, {} };
+}
+
+/// Random automaton over four letters with two transitions per state and letter.
+Nfa random_nfa(const size_t num_of_states) {
+    std::mt19937_64 random{ 42 };
+    Delta delta{ num_of_states };
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        for (Symbol symbol{ 'a' }; symbol < 'a' + 4; ++symbol) {
+            for (size_t i{ 0 }; i < 2; ++i) { delta.add(state, symbol, random() % num_of_states); }
+        }
+    }
+    return Nfa{ std::move(delta), { 0 }, { num_of_states - 1 }, {} };
+}
+
+void bench_simulate(const std::string& name, Nfa nfa, const std::string& input) {
+    bool accepted{ false };
+    nfa.freeze(false);
+    const double general_seconds{ bench::measure([&] { accepted = nfa.simulate(input); }) };
+    const bool general_accepted{ accepted };
+    bench::report(name + " [frozen]", general_seconds, input.size());
+
+    nfa.freeze();
+    const double seconds{ bench::measure([&] { accepted = nfa.simulate(input); }) };
+    bench::report(name + (nfa.isBitParallel() ? " [bit-parallel]" : " [frozen]"), seconds, input.size());
+    if (accepted != general_accepted) {
+        std::cerr << name << ": the simulations disagree\n";
+        std::exit(1);
+    }
+}
+
+} // namespace.
+
+int main() {
+    constexpr size_t INPUT_LENGTH{ 20000 };
+    std::mt19937_64 random{ 7 };
+    std::string input(INPUT_LENGTH, 'a');
+    for (char& c : input) { c = static_cast<char>('a' + random() % 4); }
+
+    std::cout << "Times are per input byte.\n";
+    for (const size_t num_of_states : { 16, 64, 128, 256, 512 }) {
+        bench_simulate("chain, " + std::to_string(num_of_states) + " states", chain_nfa(num_of_states), input);
+    }
+    for (const size_t num_of_states : { 16, 64, 128, 256, 512 }) {
+        bench_simulate("random, " + std::to_string(num_of_states) + " states", random_nfa(num_of_states), input);
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+// Benchmark of counter registers of different widths and arithmetic policies, executing the same annotations.
+//  The throwing policy reproduces the former registers, which raised exceptions on overflow and underflow.
+
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+#include "bench.hh"
+#include "mata/nfa/theta.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+constexpr size_t NUM_OF_COUNTERS{ 8 };
+constexpr size_t NUM_OF_GROUPS{ 1024 };
+
+template<class Value>
+struct ThrowingArithmetic {
+    bool increment(Value& value, const CounterValue amount) const {
+        if (amount > static_cast<CounterValue>(std::numeric_limits<Value>::max() - value)) {
+            throw std::overflow_error("CounterRegister: Increment operation would result in overflow.");
+        }
+        value = static_cast<Value>(value + amount);
+        return true;
+    }
+    bool decrement(Value& value, const CounterValue amount) const {
+        if (amount > value) {
+            throw std::underflow_error("CounterRegister: Decrement operation would result in a negative value.");
+        }
+        value = static_cast<Value>(value - amount);
+        return true;
+    }
+
+    auto operator<=>(const ThrowingArithmetic&) const = default;
+};
+
+/// Groups incrementing or decrementing a counter while it stays in a range, or resetting it.
+Theta build_theta() {
+    std::mt19937_64 random{ 42 };
+    Theta theta{};
+    for (size_t group{ 0 }; group < NUM_OF_GROUPS; ++group) {
+        const size_t counter_id{ random() % NUM_OF_COUNTERS };
+        switch (random() % 8) {
+            case 0: theta.add({ Annotation::reset(counter_id) }); break;
+            case 1:
+                theta.add({ Annotation::testGreaterEqual(counter_id, 1), Annotation::decrement(counter_id) });
+                break;
+            default: theta.add({ Annotation::testLess(counter_id, 100), Annotation::increment(counter_id) }); break;
+        }
+    }
+    return theta;
+}
+
+template<unsigned Width, template<class> class Arithmetic>
+void bench_policy(const std::string& policy, const Theta& theta, const std::vector<size_t>& ids) {
+    using RegisterSet = BasicCounterRegisterSet<CounterValueOfWidth<Width>, Arithmetic>;
+    RegisterSet counters{};
+    for (size_t i{ 0 }; i < NUM_OF_COUNTERS; ++i) { counters.addCounter(0); }
+
+    size_t passed{ 0 };
+    const double seconds{ bench::measure([&] {
+        for (const size_t id : ids) { passed += theta.execute(id, counters); }
+    }) };
+    bench::do_not_optimize(passed);
+    bench::report(policy + ", " + std::to_string(Width) + "-bit ("
+                  + std::to_string(sizeof(typename RegisterSet::Register)) + " B per register)",
+                  seconds, ids.size());
+}
+
+template<template<class> class Arithmetic>
+void bench_widths(const std::string& policy, const Theta& theta, const std::vector<size_t>& ids) {
+    bench_policy<8, Arithmetic>(policy, theta, ids);
+    bench_policy<16, Arithmetic>(policy, theta, ids);
+    bench_policy<32, Arithmetic>(policy, theta, ids);
+    bench_policy<64, Arithmetic>(policy, theta, ids);
+}
+
+/// Increments without guards on 8-bit counters, so that most of them overflow (as on adversarial input).
+template<template<class> class Arithmetic>
+void bench_overflow(const std::string& policy, const std::vector<size_t>& ids) {
+    Theta theta{};
+    for (size_t counter_id{ 0 }; counter_id < NUM_OF_COUNTERS; ++counter_id) {
+        theta.add({ Annotation::increment(counter_id, 100) });
+    }
+    BasicCounterRegisterSet<uint8_t, Arithmetic> counters{};
+    for (size_t i{ 0 }; i < NUM_OF_COUNTERS; ++i) { counters.addCounter(0); }
+
+    size_t passed{ 0 };
+    const double seconds{ bench::measure([&] {
+        for (const size_t id : ids) {
+            try {
+                passed += theta.execute(id % NUM_OF_COUNTERS, counters);
+            } catch (const std::overflow_error&) {}
+        }
+    }) };
+    bench::do_not_optimize(passed);
+    bench::report(policy + ", overflowing 8-bit increments", seconds, ids.size());
+}
+
+} // namespace.
+
+int main() {
+    const Theta theta{ build_theta() };
+    std::mt19937_64 random{ 7 };
+    std::vector<size_t> ids(1 << 22);
+    for (size_t& id : ids) { id = random() % NUM_OF_GROUPS; }
+
+    std::cout << "Times are per executed group of annotations.\n";
+    bench_widths<ThrowingArithmetic>("throwing", theta, ids);
+    bench_widths<CheckedArithmetic>("checked", theta, ids);
+    bench_widths<SaturatingArithmetic>("saturating", theta, ids);
+    bench_widths<ModularArithmetic>("modular", theta, ids);
+    bench_widths<BoundedArithmetic>("bounded", theta, ids);
+
+    const std::vector<size_t> overflow_ids(ids.begin(), ids.begin() + (1 << 16));
+    bench_overflow<ThrowingArithmetic>("throwing", overflow_ids);
+    bench_overflow<CheckedArithmetic>("checked", overflow_ids);
+    bench_overflow<SaturatingArithmetic>("saturating", overflow_ids);
+    return 0;
+}
@@ -0,0 +1,106 @@
+// Benchmark of the counter-aware simulation on counting constraints.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "bench.hh"
+#include "mata/nfa/nfa.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+/**
+ * Automaton for a{n,m}b (or .*a{n,m}b when @p search): counter 0 counts the a's read in state 1.
+ *
+ * State 0 is initial (with a self-loop over all bytes when searching), state 2 is final.
+ */
+Nfa counting_nfa(const CounterValue n, const CounterValue m, const bool search) {
+    Delta delta{ 3 };
+    if (search) {
+        for (Symbol symbol{ 1 }; symbol < 256; ++symbol) { delta.add(0, symbol, 0); }
+    }
+    delta.add(0, 'a', 1, 0);
+    delta.add(1, 'a', 1, 1);
+    delta.add(1, 'b', 2, 2);
+
+    CounterSet counters{};
+    counters.addCounter(0);
+
+    Theta theta{};
+    // Enter the counting loop with the first a.
+    theta.add({ Annotation::increment(0) });
+    theta.add({ Annotation::testLess(0, m), Annotation::increment(0) });
+    theta.add({ Annotation::testGreaterEqual(0, n) });
+
+    Nfa nfa{ std::move(delta), { 0 }, { 2 }, counters };
+    nfa.theta = std::move(theta);
+    return nfa;
+}
+
+/**
+ * Automaton for .*a{n}b with two counters counting the same a's: counter 1 bounds the loop, counter 0 is tested on
+ *  exit. The counters are correlated, so state 1 keeps a configuration per suffix of a's and the loop guard is
+ *  evaluated for all of them at once.
+ */
+Nfa correlated_nfa(const CounterValue n) {
+    Delta delta{ 3 };
+    for (Symbol symbol{ 1 }; symbol < 256; ++symbol) { delta.add(0, symbol, 0); }
+    delta.add(0, 'a', 1, 0);
+    delta.add(1, 'a', 1, 1);
+    delta.add(1, 'b', 2, 2);
+
+    CounterSet counters{};
+    counters.addCounter(0);
+    counters.addCounter(0);
+
+    Theta theta{};
+    theta.add({ Annotation::increment(0), Annotation::increment(1) });
+    theta.add({ Annotation::testLess(1, n), Annotation::increment(0), Annotation::increment(1) });
+    theta.add({ Annotation::testEqual(0, n) });
+
+    Nfa nfa{ std::move(delta), { 0 }, { 2 }, counters };
+    nfa.theta = std::move(theta);
+    return nfa;
+}
+
+void bench_correlated(const CounterValue n) {
+    const Nfa nfa{ correlated_nfa(n) };
+    const std::string input(std::string(2 * n, 'a') + "b");
+    const std::string name{ ".*a{" + std::to_string(n) + "}b, correlated counters" };
+
+    bool accepted{ false };
+    const double seconds{ bench::measure([&] { accepted = nfa.simulateWithCounters(input); }) };
+    if (!accepted) {
+        std::cerr << name << ": the input is not accepted\n";
+        std::exit(1);
+    }
+    bench::report(name, seconds, input.size());
+}
+
+void bench_counting(const CounterValue n, const CounterValue m, const bool search) {
+    const Nfa nfa{ counting_nfa(n, m, search) };
+    // Searching keeps a configuration for each suffix of a's, up to m of them.
+    const std::string input(std::string(search ? 2 * m : n, 'a') + "b");
+    const std::string name{ std::string(search ? ".*" : "") + "a{" + std::to_string(n)
+                            + (m == n ? "" : "," + std::to_string(m)) + "}b" };
+
+    bool accepted{ false };
+    const double seconds{ bench::measure([&] { accepted = nfa.simulateWithCounters(input); }) };
+    if (!accepted) {
+        std::cerr << name << ": the input is not accepted\n";
+        std::exit(1);
+    }
+    bench::report(name, seconds, input.size());
+}
+
+} // namespace.
+
+int main() {
+    std::cout << "Times are per input byte.\n";
+    for (const CounterValue n : { 10, 100, 1000, 10000 }) { bench_counting(n, n, false); }
+    for (const CounterValue n : { 10, 100, 1000, 10000 }) { bench_counting(n, n, true); }
+    for (const CounterValue n : { 10, 100, 1000, 10000 }) { bench_counting(n, 2 * n, true); }
+    for (const CounterValue n : { 10, 100, 1000 }) { bench_correlated(n); }
+    return 0;
+}
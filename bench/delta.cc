@@ -0,0 +1,154 @@
+// Benchmark of Delta across automaton sizes and densities: construction (sorted, unsorted and bulk through
+//  DeltaBuilder), getStatePost and find latency, and simulation throughput over matching input.
+//
+// The automata and inputs come from the seeded generator (generator.hh), so runs are on identical data.
+//
+// The sizes and densities (transitions per state) are taken from the comma-separated environment variables
+//  BENCH_STATES and BENCH_DENSITIES, if set.
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+#include "bench.hh"
+#include "mata/nfa/delta-builder.hh"
+#include "mata/nfa/generator.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+constexpr Symbol NUM_OF_SYMBOLS{ 16 };
+constexpr size_t NUM_OF_LOOKUPS{ 1 << 20 };
+/// Input lengths are chosen so that every simulation examines about this many transitions.
+constexpr size_t SIMULATION_BUDGET{ size_t{ 1 } << 22 };
+
+struct Transition {
+    State source;
+    Symbol symbol;
+    State target;
+
+    auto operator<=>(const Transition&) const = default;
+};
+
+std::vector<Transition> transitions_of(const Delta& delta) {
+    std::vector<Transition> transitions{};
+    for (State source{ 0 }; source < delta.numStates(); ++source) {
+        for (const SymbolPost& symbol_post : delta.getStatePost(source)) {
+            for (const Target& target : symbol_post.targets) {
+                transitions.push_back({ source, symbol_post.symbol, target.state });
+            }
+        }
+    }
+    return transitions;
+}
+
+Delta build_delta(const size_t num_of_states, const std::vector<Transition>& transitions) {
+    Delta delta{ num_of_states };
+    for (const Transition& transition : transitions) {
+        delta.add(transition.source, transition.symbol, transition.target);
+    }
+    return delta;
+}
+
+void bench_add(const std::string& name, const size_t num_of_states, std::vector<Transition> transitions,
+               const bench::Parameters& parameters) {
+    std::sort(transitions.begin(), transitions.end());
+    const double sorted_seconds{ bench::measure([&] {
+        bench::do_not_optimize(build_delta(num_of_states, transitions).numStates());
+    }) };
+    bench::report("Delta::add sorted, " + name, sorted_seconds, transitions.size(), parameters);
+
+    std::shuffle(transitions.begin(), transitions.end(), std::mt19937_64{ 7 });
+    const double unsorted_seconds{ bench::measure([&] {
+        bench::do_not_optimize(build_delta(num_of_states, transitions).numStates());
+    }) };
+    bench::report("Delta::add unsorted, " + name, unsorted_seconds, transitions.size(), parameters);
+
+    const double bulk_seconds{ bench::measure([&] {
+        DeltaBuilder builder{};
+        builder.reserve(transitions.size());
+        for (const Transition& transition : transitions) {
+            builder.add(transition.source, transition.symbol, transition.target);
+        }
+        bench::do_not_optimize(builder.build(num_of_states).numStates());
+    }) };
+    bench::report("DeltaBuilder bulk, " + name, bulk_seconds, transitions.size(), parameters);
+}
+
+void bench_lookup(const std::string& name, const Delta& delta, const bench::Parameters& parameters) {
+    std::mt19937_64 random{ 11 };
+    std::vector<State> states(NUM_OF_LOOKUPS);
+    std::vector<Symbol> symbols(NUM_OF_LOOKUPS);
+    for (size_t i{ 0 }; i < NUM_OF_LOOKUPS; ++i) {
+        states[i] = random() % delta.numStates();
+        // A quarter of the searched symbols are absent.
+        symbols[i] = 'a' + static_cast<Symbol>(random() % (NUM_OF_SYMBOLS + NUM_OF_SYMBOLS / 3));
+    }
+
+    size_t sum{ 0 };
+    const double post_seconds{ bench::measure([&] {
+        for (const State state : states) { sum += delta.getStatePost(state).size(); }
+    }) };
+    bench::report("Delta::getStatePost, " + name, post_seconds, NUM_OF_LOOKUPS, parameters);
+
+    const double find_seconds{ bench::measure([&] {
+        for (size_t i{ 0 }; i < NUM_OF_LOOKUPS; ++i) {
+            const StatePost& state_post{ delta.getStatePost(states[i]) };
+            sum += state_post.find(symbols[i]) != state_post.end();
+        }
+    }) };
+    bench::do_not_optimize(sum);
+    bench::report("StatePost::find, " + name, find_seconds, NUM_OF_LOOKUPS, parameters);
+}
+
+void bench_simulate(const std::string& name, Nfa nfa, const size_t density, const bench::Parameters& parameters) {
+    CorpusParameters corpus{};
+    corpus.seed = 13;
+    corpus.num_of_words = 1;
+    corpus.length = std::max<size_t>(16, SIMULATION_BUDGET / (nfa.numStates() * density));
+    corpus.alphabet_size = NUM_OF_SYMBOLS;
+    std::vector<std::string> words{ generateMatchingWords(nfa, corpus) };
+    if (words.empty()) { words = generateNonMatchingWords(nfa, corpus); }
+    const std::string& input{ words.front() };
+
+    bool accepted{ false };
+    const double seconds{ bench::measure([&] { accepted = nfa.simulate(input); }) };
+    bench::report_throughput("Nfa::simulate, " + name, seconds, input.size(), parameters);
+
+    nfa.freeze();
+    bool frozen_accepted{ false };
+    const double frozen_seconds{ bench::measure([&] { frozen_accepted = nfa.simulate(input); }) };
+    bench::report_throughput("Nfa::simulate frozen, " + name, frozen_seconds, input.size(), parameters);
+    if (accepted != frozen_accepted) {
+        std::cerr << name << ": the simulations disagree\n";
+        std::exit(1);
+    }
+}
+
+} // namespace.
+
+int main() {
+    const std::vector<size_t> sizes{ bench::parameter_values("BENCH_STATES", { 1000, 10000, 100000 }) };
+    const std::vector<size_t> densities{ bench::parameter_values("BENCH_DENSITIES", { 2, 8, 32 }) };
+
+    for (const size_t num_of_states : sizes) {
+        for (const size_t density : densities) {
+            const std::string name{ std::to_string(num_of_states) + " states, " + std::to_string(density)
+                                    + " transitions per state" };
+            const bench::Parameters parameters{ { "states", num_of_states }, { "density", density } };
+            GeneratorParameters generator{};
+            generator.seed = 42;
+            generator.num_of_states = num_of_states;
+            generator.alphabet_size = NUM_OF_SYMBOLS;
+            generator.out_degree = static_cast<double>(density);
+            generator.distribution = DegreeDistribution::Constant;
+            Nfa nfa{ generateNfa(generator) };
+
+            bench_add(name, num_of_states, transitions_of(nfa.delta), parameters);
+            bench_lookup(name, nfa.delta, parameters);
+            bench_simulate(name, std::move(nfa), density, parameters);
+        }
+    }
+    return 0;
+}
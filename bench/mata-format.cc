@@ -0,0 +1,64 @@
+// Benchmark of the .mata text format: parsing from memory and from a mapped file, and writing.
+//
+// The sizes (numbers of states) are taken from the comma-separated environment variable BENCH_STATES, if set.
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "bench.hh"
+#include "mata/nfa/generator.hh"
+#include "mata/nfa/mata-format.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+constexpr size_t DENSITY{ 8 };
+
+void bench_size(const size_t num_of_states, const std::string& path) {
+    const std::string name{ std::to_string(num_of_states) + " states" };
+    const bench::Parameters parameters{ { "states", num_of_states }, { "density", DENSITY } };
+    GeneratorParameters generator{};
+    generator.seed = 42;
+    generator.num_of_states = num_of_states;
+    generator.alphabet_size = 16;
+    generator.out_degree = static_cast<double>(DENSITY);
+    generator.distribution = DegreeDistribution::Constant;
+    generator.num_of_counters = 2;
+    generator.annotation_density = 0.01;
+    const Nfa nfa{ generateNfa(generator) };
+
+    std::ostringstream output{};
+    const double write_seconds{ bench::measure([&] { writeMata(nfa, output); }) };
+    const std::string text{ output.str() };
+    bench::report_throughput("writeMata, " + name, write_seconds, text.size(), parameters);
+
+    Nfa parsed{};
+    const double parse_seconds{ bench::measure([&] { parsed = parseMata(text); }) };
+    bench::report_throughput("parseMata, " + name, parse_seconds, text.size(), parameters);
+
+    std::ofstream{ path } << text;
+    const double load_seconds{ bench::measure([&] { parsed = loadMata(path); }) };
+    bench::report_throughput("loadMata, " + name, load_seconds, text.size(), parameters);
+
+    std::ostringstream round_trip{};
+    writeMata(parsed, round_trip);
+    if (round_trip.str() != text) {
+        std::cerr << name << ": the parsed automaton differs\n";
+        std::exit(1);
+    }
+}
+
+} // namespace.
+
+int main() {
+    const std::string path{ (std::filesystem::temp_directory_path() / "mata-bench-format.mata").string() };
+    for (const size_t num_of_states : bench::parameter_values("BENCH_STATES", { 10000, 100000, 1000000 })) {
+        bench_size(num_of_states, path);
+    }
+    std::remove(path.c_str());
+    return 0;
+}
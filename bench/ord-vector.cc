@@ -0,0 +1,110 @@
+// Benchmark of OrdVector: per-container overhead and find/insert speed, also inside Delta construction and simulation.
+
+#include <iostream>
+#include <random>
+
+#include "bench.hh"
+#include "mata/nfa/nfa.hh"
+
+using namespace mata::nfa;
+using mata::utils::OrdVector;
+
+namespace {
+
+void bench_sizes() {
+    std::cout << "sizeof(OrdVector<State>) = " << sizeof(OrdVector<State>) << " B\n"
+              << "sizeof(TargetSet)        = " << sizeof(TargetSet) << " B\n"
+              << "sizeof(SymbolPost)       = " << sizeof(SymbolPost) << " B\n"
+              << "sizeof(StatePost)        = " << sizeof(StatePost) << " B\n";
+}
+
+void bench_find(const size_t size) {
+    std::mt19937_64 random{ 42 };
+    StateSet set{};
+    for (State state{ 0 }; state < size; ++state) { set.push_back(2 * state); }
+    std::vector<State> keys(1 << 16);
+    for (State& key : keys) { key = random() % (2 * size); }
+
+    constexpr size_t NUM_OF_ROUNDS{ 32 };
+    size_t found{ 0 };
+    const double seconds{ bench::measure([&] {
+        for (size_t round{ 0 }; round < NUM_OF_ROUNDS; ++round) {
+            for (const State key : keys) { found += set.find(key) != set.end(); }
+        }
+    }) };
+    bench::do_not_optimize(found);
+    bench::report("OrdVector::find, size " + std::to_string(size), seconds, NUM_OF_ROUNDS * keys.size());
+}
+
+void bench_insert(const size_t size) {
+    std::mt19937_64 random{ 42 };
+    std::vector<State> keys(size);
+    for (State& key : keys) { key = random() % (4 * size); }
+
+    const size_t NUM_OF_ROUNDS{ std::max<size_t>(16, (size_t{ 1 } << 20) / size) };
+    const double seconds{ bench::measure([&] {
+        for (size_t round{ 0 }; round < NUM_OF_ROUNDS; ++round) {
+            StateSet set{};
+            for (const State key : keys) { set.insert(key); }
+            bench::do_not_optimize(set);
+        }
+    }) };
+    bench::report("OrdVector::insert, size " + std::to_string(size), seconds, NUM_OF_ROUNDS * keys.size());
+}
+
+Delta random_delta(const size_t num_of_states, const size_t num_of_transitions, const Symbol alphabet_size) {
+    std::mt19937_64 random{ 42 };
+    Delta delta{ num_of_states };
+    for (size_t i{ 0 }; i < num_of_transitions; ++i) {
+        delta.add(random() % num_of_states, 'a' + static_cast<Symbol>(random() % alphabet_size),
+                  random() % num_of_states);
+    }
+    return delta;
+}
+
+void bench_delta_add(const size_t num_of_states, const size_t num_of_transitions) {
+    const double seconds{ bench::measure([&] { bench::do_not_optimize(random_delta(num_of_states, num_of_transitions, 16)); }) };
+    bench::report("Delta::add, " + std::to_string(num_of_transitions) + " transitions, "
+                  + std::to_string(num_of_states) + " states", seconds, num_of_transitions);
+}
+
+/// Heap memory per state of a delta built by @c Delta::add(), before and after @c Delta::shrinkToFit().
+void bench_delta_memory(const size_t num_of_states, const size_t num_of_transitions) {
+    Delta delta{ random_delta(num_of_states, num_of_transitions, 16) };
+    const auto per_state = [&](const mata::utils::MemoryUsage usage) {
+        return static_cast<double>(usage.total()) / static_cast<double>(num_of_states);
+    };
+    const DeltaMemoryUsage built{ delta.memoryUsage() };
+    delta.shrinkToFit();
+    const DeltaMemoryUsage shrunk{ delta.memoryUsage() };
+    std::cout << "Delta memory, " << num_of_transitions << " transitions, " << num_of_states << " states: "
+              << per_state(built.total()) << " B/state (" << per_state({ 0, built.total().slack }) << " B slack), "
+              << per_state(shrunk.total()) << " B/state after shrinkToFit()\n";
+}
+
+void bench_simulate(const size_t num_of_states, const size_t num_of_transitions, const size_t input_length) {
+    Nfa nfa{ random_delta(num_of_states, num_of_transitions, 4), { 0 }, {}, {} };
+    std::mt19937_64 random{ 7 };
+    std::string input(input_length, 'a');
+    for (char& c : input) { c = static_cast<char>('a' + random() % 4); }
+
+    bool accepted{ false };
+    const double seconds{ bench::measure([&] { accepted = nfa.simulate(input); }) };
+    bench::do_not_optimize(accepted);
+    bench::report("Nfa::simulate, " + std::to_string(num_of_states) + " states", seconds, input_length);
+}
+
+} // namespace.
+
+int main() {
+    bench_sizes();
+    for (const size_t size : { 8, 64, 1024, 65536 }) { bench_find(size); }
+    for (const size_t size : { 8, 64, 1024, 16384 }) { bench_insert(size); }
+    bench_delta_add(10000, 1000000);
+    // Sparse automaton: one or two targets per symbol post.
+    bench_delta_add(500000, 1000000);
+    bench_delta_memory(10000, 1000000);
+    bench_delta_memory(500000, 1000000);
+    bench_simulate(1000, 8000, 10000);
+    return 0;
+}
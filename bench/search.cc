@@ -0,0 +1,127 @@
+// Microbenchmark of lower bound search strategies over sorted State vectors of various sizes.
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "bench.hh"
+#include "mata/nfa/types.hh"
+#include "mata/utils/search.hh"
+
+using namespace mata::nfa;
+using namespace mata::utils;
+
+namespace {
+
+/**
+ * @brief Read-only search index over a sorted sequence in the Eytzinger (BFS) layout.
+ *
+ * The keys are stored as an implicit binary search tree (children of node @c k are @c 2k and @c 2k + 1), so the first
+ *  levels of all searches share cache lines and the next nodes can be prefetched. It beats @c branchless_lower_bound
+ *  only from about 2^18 keys, more than any set or state post of the automata holds, so the library does not use it.
+ *
+ * @tparam Key Type of the keys. Each key is stored once more in the index, with its position in the sequence.
+ */
+template<class Key>
+class EytzingerIndex {
+public:
+    EytzingerIndex() = default;
+
+    /// Build the index over the sorted range [@p first, @p last).
+    template<class RandomIt>
+    EytzingerIndex(RandomIt first, RandomIt last) { build(first, last); }
+
+    template<class RandomIt>
+    void build(RandomIt first, RandomIt last) {
+        const auto size{ static_cast<size_t>(last - first) };
+        keys_.assign(size + 1, Key{});
+        positions_.assign(size + 1, size);
+        size_t position{ 0 };
+        build(first, position, 1);
+    }
+
+    size_t size() const { return keys_.empty() ? 0 : keys_.size() - 1; }
+    bool empty() const { return size() == 0; }
+
+    /// Position of the first key not less than @p value in the indexed sequence (its size if there is none).
+    size_t lower_bound(const Key& value) const {
+        const size_t size{ this->size() };
+        size_t node{ 1 };
+        while (node <= size) {
+            __builtin_prefetch(keys_.data() + std::min(node * 16, size));
+            node = 2 * node + (keys_[node] < value);
+        }
+        // Go up past all right turns; the node where the search last went left holds the lower bound (0 if none).
+        node >>= __builtin_ffsll(static_cast<long long>(~node));
+        return positions_[node];
+    }
+
+private:
+    /// Keys in the Eytzinger layout, index 0 is unused.
+    std::vector<Key> keys_{};
+    /// Position of each key in the original sequence, @c positions_[0] is the size of the sequence.
+    std::vector<size_t> positions_{};
+
+    template<class RandomIt>
+    void build(const RandomIt first, size_t& position, const size_t node) {
+        if (node >= keys_.size()) { return; }
+        build(first, position, 2 * node);
+        keys_[node] = first[static_cast<typename std::iterator_traits<RandomIt>::difference_type>(position)];
+        positions_[node] = position++;
+        build(first, position, 2 * node + 1);
+    }
+};
+
+template<class RandomIt, class T>
+RandomIt linear_lower_bound(RandomIt first, const RandomIt last, const T& value) {
+    while (first != last && *first < value) { ++first; }
+    return first;
+}
+
+template<class Search>
+void bench_search(const std::string& name, const size_t size, const std::vector<State>& keys, Search&& search) {
+    const size_t num_of_rounds{ std::max<size_t>(1, (size_t{ 1 } << 22) / keys.size()) };
+    size_t sum{ 0 };
+    const double seconds{ bench::measure([&] {
+        for (size_t round{ 0 }; round < num_of_rounds; ++round) {
+            for (const State key : keys) { sum += search(key); }
+        }
+    }) };
+    bench::do_not_optimize(sum);
+    bench::report(name + ", size " + std::to_string(size), seconds, num_of_rounds * keys.size());
+}
+
+void bench_size(const size_t size) {
+    std::mt19937_64 random{ 42 };
+    std::vector<State> sorted(size);
+    for (size_t i{ 0 }; i < size; ++i) { sorted[i] = 2 * i; }
+    std::vector<State> keys(1 << 16);
+    for (State& key : keys) { key = random() % (2 * size); }
+    const EytzingerIndex<State> eytzinger{ sorted.begin(), sorted.end() };
+
+    const auto position = [&](const auto it) { return static_cast<size_t>(it - sorted.begin()); };
+    if (size <= 64) {
+        bench_search("linear", size, keys, [&](const State key) {
+            return position(linear_lower_bound(sorted.begin(), sorted.end(), key));
+        });
+    }
+    bench_search("std::lower_bound", size, keys, [&](const State key) {
+        return position(std::lower_bound(sorted.begin(), sorted.end(), key));
+    });
+    bench_search("branchless_lower_bound", size, keys, [&](const State key) {
+        return position(branchless_lower_bound(sorted.begin(), sorted.end(), key));
+    });
+    bench_search("EytzingerIndex", size, keys, [&](const State key) { return eytzinger.lower_bound(key); });
+    bench_search("OrdVector::find", size, keys, [&, set = StateSet{ sorted }](const State key) {
+        return static_cast<size_t>(set.find(key) - set.begin());
+    });
+}
+
+} // namespace.
+
+int main() {
+    for (size_t size{ 4 }; size <= (size_t{ 1 } << 20); size *= 4) { bench_size(size); }
+    return 0;
+}
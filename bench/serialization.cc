@@ -0,0 +1,91 @@
+// Benchmark of the binary format of automata: building and freezing a delta versus mapping a saved automaton, and
+//  the simulation throughput of the mapped automaton.
+//
+// The sizes (numbers of states) are taken from the comma-separated environment variable BENCH_STATES, if set.
+
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+#include "bench.hh"
+#include "mata/nfa/delta-builder.hh"
+#include "mata/nfa/generator.hh"
+#include "mata/nfa/serialization.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+constexpr Symbol NUM_OF_SYMBOLS{ 16 };
+constexpr size_t DENSITY{ 8 };
+constexpr size_t INPUT_LENGTH{ 1 << 16 };
+
+void bench_size(const size_t num_of_states, const std::string& path) {
+    const std::string name{ std::to_string(num_of_states) + " states" };
+    const bench::Parameters parameters{ { "states", num_of_states }, { "density", DENSITY } };
+    GeneratorParameters generator{};
+    generator.seed = 42;
+    generator.num_of_states = num_of_states;
+    generator.alphabet_size = NUM_OF_SYMBOLS;
+    generator.out_degree = static_cast<double>(DENSITY);
+    generator.distribution = DegreeDistribution::Constant;
+    const Nfa nfa{ generateNfa(generator) };
+    size_t num_of_transitions{ 0 };
+    for (State source{ 0 }; source < nfa.delta.numStates(); ++source) {
+        for (const SymbolPost& symbol_post : nfa.delta.getStatePost(source)) {
+            num_of_transitions += symbol_post.targets.size();
+        }
+    }
+
+    const double build_seconds{ bench::measure([&] {
+        DeltaBuilder builder{};
+        builder.reserve(num_of_transitions);
+        for (State source{ 0 }; source < nfa.delta.numStates(); ++source) {
+            for (const SymbolPost& symbol_post : nfa.delta.getStatePost(source)) {
+                for (const Target& target : symbol_post.targets) {
+                    builder.add(source, symbol_post.symbol, target.state);
+                }
+            }
+        }
+        const FrozenDelta frozen_delta{ builder.build(num_of_states) };
+        bench::do_not_optimize(frozen_delta.numStates());
+    }) };
+    bench::report("DeltaBuilder and freeze, " + name, build_seconds, num_of_transitions, parameters);
+
+    const double save_seconds{ bench::measure([&] { saveNfa(nfa, path); }) };
+    bench::report("saveNfa, " + name, save_seconds, num_of_transitions, parameters);
+    const size_t file_size{ std::filesystem::file_size(path) };
+    bench::report_throughput("saveNfa written bytes, " + name, save_seconds, file_size, parameters);
+
+    const double load_seconds{ bench::measure([&] { bench::do_not_optimize(MappedNfa{ path }.numStates()); }) };
+    bench::report("MappedNfa load, " + name, load_seconds, 1, parameters);
+
+    CorpusParameters corpus{};
+    corpus.seed = 13;
+    corpus.num_of_words = 1;
+    corpus.length = INPUT_LENGTH;
+    corpus.alphabet_size = NUM_OF_SYMBOLS;
+    std::vector<std::string> words{ generateMatchingWords(nfa, corpus) };
+    if (words.empty()) { words = generateNonMatchingWords(nfa, corpus); }
+    const std::string& input{ words.front() };
+
+    const MappedNfa mapped_nfa{ path };
+    bool accepted{ false };
+    const double simulate_seconds{ bench::measure([&] { accepted = mapped_nfa.simulate(input); }) };
+    bench::report_throughput("MappedNfa::simulate, " + name, simulate_seconds, input.size(), parameters);
+    if (accepted != nfa.simulate(input)) {
+        std::cerr << name << ": the simulations disagree\n";
+        std::exit(1);
+    }
+}
+
+} // namespace.
+
+int main() {
+    const std::string path{ (std::filesystem::temp_directory_path() / "mata-bench-serialization.nfa").string() };
+    for (const size_t num_of_states : bench::parameter_values("BENCH_STATES", { 10000, 100000, 1000000 })) {
+        bench_size(num_of_states, path);
+    }
+    std::remove(path.c_str());
+    return 0;
+}
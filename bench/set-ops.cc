@@ -0,0 +1,70 @@
+// Benchmark of OrdVector set operations with each of the available instruction sets.
+
+#include <iostream>
+#include <random>
+
+#include "bench.hh"
+#include "mata/nfa/types.hh"
+
+using namespace mata::nfa;
+namespace simd = mata::utils::simd;
+
+namespace {
+
+/// Random set of @p size states taken from [0, @p size / @p density).
+StateSet random_set(std::mt19937_64& random, const size_t size, const double density) {
+    const auto universe{ static_cast<size_t>(static_cast<double>(size) / density) };
+    std::vector<State> states{};
+    states.reserve(size);
+    for (State state{ 0 }; state < universe && states.size() < size; ++state) {
+        if (static_cast<double>(random() % 1000) < density * 1000) { states.push_back(state); }
+    }
+    return StateSet{ states };
+}
+
+void bench_set_ops(const size_t size, const double density) {
+    std::mt19937_64 random{ 42 };
+    const StateSet lhs{ random_set(random, size, density) };
+    const StateSet rhs{ random_set(random, size, density) };
+    const StateSet subset{ StateSet::intersection(lhs, rhs) };
+    const StateSet disjoint{ StateSet::difference(rhs, subset) };
+    const size_t num_of_rounds{ std::max<size_t>(4, (size_t{ 1 } << 22) / size) };
+    const size_t num_of_elements{ num_of_rounds * (lhs.size() + rhs.size()) };
+    const std::string suffix{ ", size " + std::to_string(size) + ", density " + std::to_string(density).substr(0, 4)
+                              + " [" + simd::to_string(simd::get_instruction_set()) + "]" };
+
+    bench::report("intersection" + suffix, bench::measure([&] {
+        for (size_t round{ 0 }; round < num_of_rounds; ++round) {
+            bench::do_not_optimize(StateSet::intersection(lhs, rhs));
+        }
+    }), num_of_elements);
+    bench::report("difference" + suffix, bench::measure([&] {
+        for (size_t round{ 0 }; round < num_of_rounds; ++round) {
+            bench::do_not_optimize(StateSet::difference(lhs, rhs));
+        }
+    }), num_of_elements);
+    bench::report("is_subset_of" + suffix, bench::measure([&] {
+        for (size_t round{ 0 }; round < num_of_rounds; ++round) {
+            bench::do_not_optimize(subset.is_subset_of(lhs));
+        }
+    }), num_of_rounds * (subset.size() + lhs.size()));
+    bench::report("is_intersection_empty_with" + suffix, bench::measure([&] {
+        for (size_t round{ 0 }; round < num_of_rounds; ++round) {
+            bench::do_not_optimize(lhs.is_intersection_empty_with(disjoint));
+        }
+    }), num_of_rounds * (lhs.size() + disjoint.size()));
+}
+
+} // namespace.
+
+int main() {
+    std::cout << "Times are per input element.\n";
+    for (const auto instruction_set : { simd::InstructionSet::Scalar, simd::InstructionSet::Sse41,
+                                        simd::InstructionSet::Avx2 }) {
+        if (!simd::set_instruction_set(instruction_set)) { continue; }
+        for (const size_t size : { 16, 256, 65536 }) {
+            for (const double density : { 0.1, 0.5 }) { bench_set_ops(size, density); }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+// Benchmark of executing transition annotations: flat Theta (opcode records, switch) against VirtualTheta (heap
+//  objects with virtual calls).
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include "bench.hh"
+#include "mata/nfa/annotation.hh"
+#include "mata/nfa/theta.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+constexpr size_t NUM_OF_COUNTERS{ 8 };
+constexpr CounterValue BOUND{ 1000 };
+
+/// Groups of the form [test counter < BOUND, increment counter] or [reset counter], built as both Theta kinds.
+void build(const size_t num_of_groups, Theta& theta, VirtualTheta& virtual_theta) {
+    std::mt19937_64 random{ 42 };
+    for (size_t group{ 0 }; group < num_of_groups; ++group) {
+        const size_t counter_id{ random() % NUM_OF_COUNTERS };
+        TransitionAnnotations& annotations{ virtual_theta.emplace_back() };
+        if (random() % 8 == 0) {
+            theta.add({ Annotation::reset(counter_id) });
+            annotations.push_back(std::make_unique<CounterReset>(counter_id));
+        } else {
+            theta.add({ Annotation::testLess(counter_id, BOUND), Annotation::increment(counter_id) });
+            annotations.push_back(std::make_unique<CounterTest>(counter_id, CounterTest::Comparison::Less, BOUND));
+            annotations.push_back(std::make_unique<CounterIncrement>(counter_id, 1));
+        }
+    }
+}
+
+CounterSet make_counters() {
+    CounterSet counters{};
+    for (size_t i{ 0 }; i < NUM_OF_COUNTERS; ++i) { counters.addCounter(0); }
+    return counters;
+}
+
+void bench_execute(const size_t num_of_groups) {
+    Theta theta{};
+    VirtualTheta virtual_theta{};
+    build(num_of_groups, theta, virtual_theta);
+
+    std::mt19937_64 random{ 7 };
+    std::vector<size_t> ids(1 << 20);
+    for (size_t& id : ids) { id = random() % num_of_groups; }
+
+    CounterSet counters{ make_counters() };
+    size_t passed{ 0 };
+    const double virtual_seconds{ bench::measure([&] {
+        for (const size_t id : ids) {
+            bool pass{ true };
+            for (const TransitionAnnotationPtr& annotation : virtual_theta[id]) {
+                if (!annotation->test(counters)) { pass = false; break; }
+                annotation->execute(counters);
+            }
+            passed += pass;
+        }
+    }) };
+    const CounterSet virtual_counters{ counters };
+    const size_t virtual_passed{ passed };
+    bench::report("VirtualTheta, " + std::to_string(num_of_groups) + " groups", virtual_seconds, ids.size());
+
+    counters = make_counters();
+    passed = 0;
+    const double seconds{ bench::measure([&] {
+        for (const size_t id : ids) { passed += theta.execute(id, counters); }
+    }) };
+    bench::report("Theta, " + std::to_string(num_of_groups) + " groups", seconds, ids.size());
+
+    if (passed != virtual_passed || !(counters == virtual_counters)) {
+        std::cerr << "Theta and VirtualTheta disagree\n";
+        std::exit(1);
+    }
+}
+
+} // namespace.
+
+int main() {
+    std::cout << "Times are per executed group of annotations.\n";
+    for (const size_t num_of_groups : { 16, 1024, 65536 }) { bench_execute(num_of_groups); }
+    return 0;
+}
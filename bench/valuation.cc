@@ -0,0 +1,55 @@
+// Benchmark of deduplicating counter valuations: interning packed valuations versus a set of register sets.
+
+#include <iostream>
+#include <random>
+#include <set>
+
+#include "bench.hh"
+#include "mata/nfa/valuation.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+constexpr size_t NUM_OF_VALUATIONS{ 1 << 20 };
+
+void bench_counters(const size_t num_of_counters, const CounterValue max_value) {
+    std::mt19937_64 random{ 42 };
+    std::vector<CounterValue> values(NUM_OF_VALUATIONS * num_of_counters);
+    for (CounterValue& value : values) { value = random() % (max_value + 1); }
+    const std::string name{ std::to_string(num_of_counters) + " counters with values up to "
+                            + std::to_string(max_value) };
+
+    std::set<CounterRegisterSet> set{};
+    const double set_seconds{ bench::measure([&] {
+        for (size_t i{ 0 }; i < NUM_OF_VALUATIONS; ++i) {
+            CounterRegisterSet counters{};
+            for (size_t c{ 0 }; c < num_of_counters; ++c) { counters.addCounter(values[i * num_of_counters + c]); }
+            set.insert(std::move(counters));
+        }
+    }) };
+    bench::do_not_optimize(set.size());
+    bench::report("std::set<CounterRegisterSet>, " + name, set_seconds, NUM_OF_VALUATIONS);
+
+    ValuationTable table{ num_of_counters };
+    size_t id_sum{ 0 };
+    const double table_seconds{ bench::measure([&] {
+        for (size_t i{ 0 }; i < NUM_OF_VALUATIONS; ++i) {
+            id_sum += table.intern({ values.data() + i * num_of_counters, num_of_counters });
+        }
+    }) };
+    bench::do_not_optimize(id_sum);
+    bench::report("ValuationTable, " + name, table_seconds, NUM_OF_VALUATIONS);
+    if (table.size() != set.size()) { std::cerr << "Valuation counts differ.\n"; }
+}
+
+} // namespace.
+
+int main() {
+    std::cout << "Times are per deduplicated valuation.\n";
+    bench_counters(1, 1000);
+    bench_counters(4, 10);
+    bench_counters(4, 1000);
+    bench_counters(16, 3);
+    return 0;
+}
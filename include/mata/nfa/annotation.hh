@@ -3,6 +3,7 @@
 #ifndef ANNOTATION_HH
 #define ANNOTATION_HH
 
+#include <cassert>
 #include <memory>
 
 #include "types.hh"
@@ -17,7 +18,8 @@ public:
     virtual ~TransitionAnnotation() = default;
 
     virtual void execute(CounterSet& counters) const = 0;
-    virtual bool test(const CounterSet& counters) { return true; }
+    /// Guard of the transition: the transition can be taken only if the test holds (before executing the annotation).
+    virtual bool test(const CounterSet& counters) const { return true; }
 };
 
 /// Class for incrementing and decrementing a counter by its ID.
@@ -30,10 +32,10 @@ public:
     CounterIncrement() = default;
     CounterIncrement(size_t counter_id, int increment_value) : counter_id(counter_id), increment_value(increment_value) {}
 
+    // Note: The ID is checked by the assertion only, so that the annotation can be executed without exceptions.
+    //  An increment rejected by the arithmetic policy leaves the counter unchanged.
     void execute(CounterSet& counters) const override {
-        if (counter_id >= counters.size()) {
-            throw std::runtime_error("CounterOperation: Invalid counter ID.");
-        }
+        assert(counter_id < counters.size());
 
         CounterRegister& counter = counters[counter_id];
 
@@ -45,15 +47,60 @@ public:
         }
     }
 };
-// TODO: Add CounterTest class.
+
+/// Class for resetting a counter to its initial value.
+class CounterReset : public TransitionAnnotation {
+private:
+    size_t counter_id; ///< The ID of the counter to reset.
+
+public:
+    explicit CounterReset(size_t counter_id) : counter_id(counter_id) {}
+
+    void execute(CounterSet& counters) const override {
+        assert(counter_id < counters.size());
+        counters[counter_id].reset();
+    }
+};
+
+/// Class for guarding a transition by comparing a counter with a constant.
+class CounterTest : public TransitionAnnotation {
+public:
+    enum class Comparison { Equal, Less, GreaterEqual, InRange };
+
+private:
+    size_t counter_id; ///< The ID of the tested counter.
+    Comparison comparison;
+    CounterValue value; ///< The value to compare the counter with (the lower bound for InRange).
+    CounterValue upper{ 0 }; ///< Inclusive upper bound for InRange.
+
+public:
+    CounterTest(size_t counter_id, Comparison comparison, CounterValue value)
+        : counter_id(counter_id), comparison(comparison), value(value) {}
+    /// Test that the counter lies in [@p low, @p high].
+    CounterTest(size_t counter_id, CounterValue low, CounterValue high)
+        : counter_id(counter_id), comparison(Comparison::InRange), value(low), upper(high) {}
+
+    void execute(CounterSet&) const override {}
+
+    bool test(const CounterSet& counters) const override {
+        assert(counter_id < counters.size());
+        const CounterValue counter_value{ counters[counter_id] };
+        switch (comparison) {
+            case Comparison::Equal: return counter_value == value;
+            case Comparison::Less: return counter_value < value;
+            case Comparison::GreaterEqual: return counter_value >= value;
+            case Comparison::InRange: return counter_value >= value && counter_value <= upper;
+        }
+        return false;
+    }
+};
 
 using TransitionAnnotationPtr = std::unique_ptr<TransitionAnnotation>;
 using TransitionAnnotations = std::vector<TransitionAnnotationPtr>;
 
-// Note: Theta is used to simplify the name of the TransitionAnnotations collection.
-// TODO: Try to recreate this like a class Theta (or any other Greek letter) to encapsulate the logic.
-// Theta should be similar to Delta? Probably yes. Ask about this approach.
-using Theta = std::vector<TransitionAnnotations>;
+// Collection of heap-allocated annotations executed through virtual calls, indexed by AnnotationState::annotation_id.
+// Note: The simulation uses the flat Theta class (theta.hh) instead; this is kept for extensions and comparison.
+using VirtualTheta = std::vector<TransitionAnnotations>;
 
 } // namespace mata::nfa.
 
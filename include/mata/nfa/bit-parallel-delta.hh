@@ -0,0 +1,131 @@
+#ifndef BIT_PARALLEL_DELTA_HH
+#define BIT_PARALLEL_DELTA_HH
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "frozen-delta.hh"
+
+namespace mata::nfa {
+
+/// Set of states smaller than 64 * @p NumOfWords as a bit vector.
+template<size_t NumOfWords>
+struct StateBits {
+    std::array<uint64_t, NumOfWords> words{};
+
+    void set(const State state) { words[state / 64] |= uint64_t{ 1 } << (state % 64); }
+    bool test(const State state) const { return (words[state / 64] >> (state % 64)) & 1; }
+
+    bool any() const {
+        uint64_t any{ 0 };
+        for (const uint64_t word : words) { any |= word; }
+        return any != 0;
+    }
+    size_t count() const {
+        size_t count{ 0 };
+        for (const uint64_t word : words) { count += static_cast<size_t>(std::popcount(word)); }
+        return count;
+    }
+
+    StateBits& operator|=(const StateBits& other) {
+        for (size_t i{ 0 }; i < NumOfWords; ++i) { words[i] |= other.words[i]; }
+        return *this;
+    }
+
+    StateBits operator&(const StateBits& other) const {
+        StateBits result{};
+        for (size_t i{ 0 }; i < NumOfWords; ++i) { result.words[i] = words[i] & other.words[i]; }
+        return result;
+    }
+
+    /// Move every state @c q to @c q + 1.
+    StateBits shifted() const {
+        StateBits result{};
+        result.words[0] = words[0] << 1;
+        for (size_t i{ 1 }; i < NumOfWords; ++i) { result.words[i] = (words[i] << 1) | (words[i - 1] >> 63); }
+        return result;
+    }
+
+    /// Call @p function for every state in the set, in increasing order.
+    template<class Function>
+    void forEach(Function&& function) const {
+        for (size_t i{ 0 }; i < NumOfWords; ++i) {
+            for (uint64_t word{ words[i] }; word != 0; word &= word - 1) {
+                function(static_cast<State>(64 * i + static_cast<size_t>(std::countr_zero(word))));
+            }
+        }
+    }
+
+    auto operator<=>(const StateBits&) const = default;
+};
+
+/**
+ * Transition relation of an automaton with at most @c MAX_NUM_OF_STATES states compiled for bit-parallel simulation.
+ *
+ * A set of states is a bit vector of @p NumOfWords words and a step over a byte symbol is computed with word-wide
+ *  operations (shift-and): transitions @c q -> @c q + 1 whose target has no outgoing epsilon transitions are applied
+ *  to all active states at once as @c (states << 1) & shift_targets. Only the remaining (irregular) transitions are
+ *  applied per active source state, as an OR with the precomputed epsilon-closed set of its successors.
+ *
+ * Byte symbols with identical transitions share one symbol class. Symbols outside of the byte range cannot be read
+ *  from the input and are ignored.
+ */
+template<size_t NumOfWords>
+class BitParallelDelta {
+public:
+    static constexpr size_t MAX_NUM_OF_STATES{ 64 * NumOfWords };
+    static constexpr size_t BYTE_ALPHABET_SIZE{ 256 };
+    using Bits = StateBits<NumOfWords>;
+
+    /// @pre @c delta.numStates() <= @c MAX_NUM_OF_STATES.
+    explicit BitParallelDelta(const FrozenDelta& delta);
+
+    /**
+     * Decide whether @p input is accepted from @p initial states into @p final states.
+     * @pre All states in @p initial and @p final are smaller than @c MAX_NUM_OF_STATES.
+     */
+    bool simulate(std::span<const State> initial, std::span<const State> final, const std::string& input) const;
+
+    /// Epsilon-closed successors of @p states over the byte symbol @p symbol.
+    Bits post(const Bits& states, const Symbol symbol) const {
+        const size_t symbol_class{ class_of_symbol_[symbol] };
+        const SymbolClass& transitions{ classes_[symbol_class] };
+        Bits result{ states.shifted() & transitions.shift_targets };
+        const Bits* successors{ successors_.data() + symbol_class * num_of_states_ };
+        (states & transitions.irregular_sources).forEach([&](const State state) { result |= successors[state]; });
+        return result;
+    }
+
+    /// Epsilon closure of @p states.
+    Bits epsilonClosure(std::span<const State> states) const;
+
+    size_t numStates() const { return num_of_states_; }
+    size_t numSymbolClasses() const { return classes_.size(); }
+
+    utils::MemoryUsage memoryUsage() const {
+        return utils::vector_memory_usage(classes_) + utils::vector_memory_usage(successors_)
+               + utils::vector_memory_usage(epsilon_closures_);
+    }
+
+private:
+    struct SymbolClass {
+        Bits shift_targets{}; ///< States @c q + 1 reached by the shifted transitions @c q -> @c q + 1.
+        Bits irregular_sources{}; ///< States with other transitions, see @c successors_.
+    };
+
+    size_t num_of_states_;
+    std::array<uint16_t, BYTE_ALPHABET_SIZE> class_of_symbol_{};
+    std::vector<SymbolClass> classes_{};
+    /// Epsilon-closed targets of the irregular transitions, indexed by symbol class * @c num_of_states_ + source.
+    std::vector<Bits> successors_{};
+    /// Epsilon closure of each state.
+    std::vector<Bits> epsilon_closures_{};
+};
+
+} // namespace mata::nfa.
+
+#endif // BIT_PARALLEL_DELTA_HH
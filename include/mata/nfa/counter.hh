@@ -0,0 +1,210 @@
+#ifndef COUNTER_HH
+#define COUNTER_HH
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "mata/utils/memory-usage.hh"
+#include "mata/utils/ord-vector.hh"
+
+namespace mata::nfa {
+
+// TODO: Choose the best value for counters.
+using CounterValue = unsigned long;
+using CounterValueSet = mata::utils::OrdVector<CounterValue>;
+
+/// Unsigned type of counter values with the given width in bits (8, 16, 32 or 64).
+template<unsigned Width>
+using CounterValueOfWidth = std::conditional_t<Width == 8, uint8_t,
+                            std::conditional_t<Width == 16, uint16_t,
+                            std::conditional_t<Width == 32, uint32_t, uint64_t>>>;
+
+/*
+ * Arithmetic policies of counter registers: what an increment or a decrement does when the exact result does not fit
+ *  into the values of the register.
+ *
+ * None of them throws, so register operations stay inlinable in the simulation loop. An operation returns false if
+ *  it is not allowed by the policy (the transition executing it cannot be taken); the register is then unchanged.
+ *  Amounts are given as @c CounterValue and may exceed the range of narrow value types.
+ */
+
+/// Operations leaving the range of values fail; this is the status flag replacing the overflow exceptions.
+template<class Value>
+struct CheckedArithmetic {
+    bool increment(Value& value, const CounterValue amount) const {
+        if (amount > static_cast<CounterValue>(std::numeric_limits<Value>::max() - value)) { return false; }
+        value = static_cast<Value>(value + amount);
+        return true;
+    }
+    bool decrement(Value& value, const CounterValue amount) const {
+        if (amount > value) { return false; }
+        value = static_cast<Value>(value - amount);
+        return true;
+    }
+
+    auto operator<=>(const CheckedArithmetic&) const = default;
+};
+
+/// Results are clamped to [0, maximal value].
+template<class Value>
+struct SaturatingArithmetic {
+    bool increment(Value& value, const CounterValue amount) const {
+        const CounterValue room{ static_cast<CounterValue>(std::numeric_limits<Value>::max() - value) };
+        value = amount > room ? std::numeric_limits<Value>::max() : static_cast<Value>(value + amount);
+        return true;
+    }
+    bool decrement(Value& value, const CounterValue amount) const {
+        value = amount > value ? Value{ 0 } : static_cast<Value>(value - amount);
+        return true;
+    }
+
+    auto operator<=>(const SaturatingArithmetic&) const = default;
+};
+
+/// Results wrap around modulo 2^width.
+template<class Value>
+struct ModularArithmetic {
+    bool increment(Value& value, const CounterValue amount) const {
+        value = static_cast<Value>(value + amount);
+        return true;
+    }
+    bool decrement(Value& value, const CounterValue amount) const {
+        value = static_cast<Value>(value - amount);
+        return true;
+    }
+
+    auto operator<=>(const ModularArithmetic&) const = default;
+};
+
+/**
+ * Results are clamped to [0, @c bound], where @c bound is one more than the largest constant the counter is compared
+ *  with. Guards cannot tell apart values above the largest constant, so increments stay exact for matching while
+ *  the values stay small. Decrementing a clamped value is not exact and fails.
+ */
+template<class Value>
+struct BoundedArithmetic {
+    Value bound{ std::numeric_limits<Value>::max() };
+
+    bool increment(Value& value, const CounterValue amount) const {
+        // A value above the bound (an initial value) is clamped as well, bound - value would wrap around.
+        const bool clamped{ value >= bound || amount >= static_cast<CounterValue>(bound - value) };
+        value = clamped ? bound : static_cast<Value>(value + amount);
+        return true;
+    }
+    bool decrement(Value& value, const CounterValue amount) const {
+        if (amount > value || (value >= bound && bound != std::numeric_limits<Value>::max())) { return false; }
+        value = static_cast<Value>(value - amount);
+        return true;
+    }
+
+    auto operator<=>(const BoundedArithmetic&) const = default;
+};
+
+// Register for counters with values of type @p Value and the arithmetic policy @p Arithmetic.
+template<class Value, template<class> class Arithmetic>
+struct BasicCounterRegister {
+    using ValueType = Value;
+    using ArithmeticType = Arithmetic<Value>;
+
+    static constexpr uint32_t UNDEFINED_COUNTER_ID{ std::numeric_limits<uint32_t>::max() };
+
+    uint32_t id; ///< Unique ID for the counter.
+    // Note: ID is the index in the counters vector.
+    // TODO: Is this a good idea? Think about better solutions.
+    Value value; ///< Current counter value.
+    Value initial_value; ///< Initial counter value.
+    [[no_unique_address]] ArithmeticType arithmetic{}; ///< Takes no space unless the policy has parameters.
+
+    BasicCounterRegister() : id(UNDEFINED_COUNTER_ID), value(0), initial_value(0) {}
+    BasicCounterRegister(uint32_t id, Value value, ArithmeticType arithmetic = {})
+        : id(id), value(value), initial_value(value), arithmetic(arithmetic) {}
+
+    BasicCounterRegister(const BasicCounterRegister&) = default;
+    BasicCounterRegister(BasicCounterRegister&&) = default;
+    BasicCounterRegister& operator=(const BasicCounterRegister&) = default;
+    BasicCounterRegister& operator=(BasicCounterRegister&&) = default;
+
+    BasicCounterRegister& operator=(Value other) { value = other; return *this; }
+
+    auto operator<=>(const Value& other) const { return value <=> other; }
+    auto operator<=>(const BasicCounterRegister&) const = default;
+
+    operator Value() const { return value; }
+
+    // Increment the counter by 1 (or specified amount). Returns false if the policy does not allow the result.
+    bool increment(CounterValue amount = 1) { return arithmetic.increment(value, amount); }
+    // Decrement the counter by 1 (or specified amount). Returns false if the policy does not allow the result.
+    bool decrement(CounterValue amount = 1) { return arithmetic.decrement(value, amount); }
+    // Reset the counter to its initial value.
+    void reset() { value = initial_value; }
+    // Note: Custom debug output. This should be removed later.
+    void print() const {
+        std::cout << "ID: " << id << ", Value: " << +value << ", Initial: " << +initial_value << "\n";
+    }
+};
+
+// Set of counter registers.
+template<class Value, template<class> class Arithmetic>
+class BasicCounterRegisterSet {
+public:
+    using Register = BasicCounterRegister<Value, Arithmetic>;
+
+private:
+    std::vector<Register> counters; ///< Stores counters.
+
+public:
+    // TODO: Add the necessary constructors later.
+    BasicCounterRegisterSet() = default;
+
+    void addCounter(Value value, typename Register::ArithmeticType arithmetic = {}) {
+        counters.emplace_back(static_cast<uint32_t>(counters.size()), value, arithmetic);
+    }
+    // TODO: Change this to operator.
+    // Note: Checks the ID; use operator[] in the simulation.
+    Register& getCounter(size_t id) {
+        if (id >= counters.size()) {
+            throw std::runtime_error("CounterRegisterSet: Counter with this ID does not exist.");
+        }
+        return counters[id];
+    }
+    const Register& getCounter(size_t id) const {
+        if (id >= counters.size()) {
+            throw std::runtime_error("CounterRegisterSet: Counter with this ID does not exist.");
+        }
+        return counters[id];
+    }
+    // This implementation of getCounter is probably better.
+    Register& operator[](size_t id) {
+        return counters[id];
+    }
+    const Register& operator[](size_t id) const {
+        return counters[id];
+    }
+    size_t size() const {
+        return counters.size();
+    }
+    utils::MemoryUsage memoryUsage() const { return utils::vector_memory_usage(counters); }
+    void shrinkToFit() { counters.shrink_to_fit(); }
+    // Valuations are compared register by register (used to deduplicate configurations during simulation).
+    auto operator<=>(const BasicCounterRegisterSet&) const = default;
+    // Note: Custom debug output. This should be removed later.
+    void print() const {
+        for (const auto& counter : counters) {
+            counter.print();
+        }
+    }
+    // TODO: Add counter removal later.
+    // TODO: Add iterators later.
+};
+
+// Registers used by the automata: full-width values, failing operations on overflow.
+using CounterRegister = BasicCounterRegister<CounterValue, CheckedArithmetic>;
+using CounterRegisterSet = BasicCounterRegisterSet<CounterValue, CheckedArithmetic>;
+
+} // namespace mata::nfa.
+
+#endif // COUNTER_HH
@@ -0,0 +1,180 @@
+#ifndef COUNTING_SET_HH
+#define COUNTING_SET_HH
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+#include "types.hh"
+
+namespace mata::nfa {
+
+/**
+ * Set of values of a single counter, shared by all configurations that differ only in this counter.
+ *
+ * Values are stored as keys relative to a common offset (value = key + offset), sorted by value. Incrementing or
+ *  decrementing all values only moves the offset, so it takes constant time regardless of the number of values.
+ *  Guards keep an interval of values, which drops values from the ends of the sequence. New values entering
+ *  a counting loop are usually the smallest ones and are inserted in constant time.
+ *
+ * The size is bounded by @c saturate(): values above the largest constant the counter is compared with cannot be
+ *  told apart by any guard, so they are collapsed into a single value.
+ */
+class CountingSet {
+public:
+    CountingSet() = default;
+    explicit CountingSet(const CounterValue value) : keys_{ value } {}
+
+    bool empty() const { return size() == 0; }
+    size_t size() const { return keys_.size() - head_; }
+
+    CounterValue min() const { assert(!empty()); return keys_.back() + offset_; }
+    CounterValue max() const { assert(!empty()); return keys_[head_] + offset_; }
+    /// The @p index-th smallest value.
+    CounterValue operator[](const size_t index) const { return keys_[keys_.size() - 1 - index] + offset_; }
+
+    /// Whether some value lies in [@p low, @p high].
+    bool intersects(const CounterValue low, const CounterValue high) const {
+        const size_t first{ lowerBound(low) };
+        return first < size() && (*this)[first] <= high;
+    }
+
+    /// Add @p amount to all values.
+    void incrementAll(const CounterValue amount) { offset_ += amount; }
+    /// Subtract @p amount from all values. All values must be at least @p amount.
+    void decrementAll(const CounterValue amount) {
+        assert(empty() || min() >= amount);
+        offset_ -= amount;
+    }
+
+    /// Keep only the values in [@p low, @p high].
+    void keepRange(const CounterValue low, const CounterValue high) {
+        while (!empty() && min() < low) { keys_.pop_back(); }
+        while (!empty() && max() > high) { ++head_; }
+        compact();
+    }
+
+    /// Copy of the values in [@p low, @p high], without copying the other values.
+    CountingSet slice(const CounterValue low, const CounterValue high) const {
+        CountingSet result{};
+        result.offset_ = offset_;
+        const size_t first{ lowerBound(low) };
+        const size_t last{ std::max(first, upperBound(high)) };
+        result.keys_.assign(keys_.end() - static_cast<long>(last), keys_.end() - static_cast<long>(first));
+        return result;
+    }
+
+    /**
+     * Insert @p value. Constant time if @p value is smaller than all values (or larger, if a larger value has been
+     *  dropped before), linear otherwise.
+     * @return True if @p value was not present.
+     */
+    bool insert(const CounterValue value) {
+        if (empty() || value < min()) { keys_.push_back(value - offset_); return true; }
+        if (value > max() && head_ > 0) { keys_[--head_] = value - offset_; return true; }
+        const size_t position{ lowerBound(value) };
+        if (position < size() && (*this)[position] == value) { return false; }
+        keys_.insert(keys_.end() - static_cast<long>(position), value - offset_);
+        return true;
+    }
+
+    /**
+     * Insert all values of @p other.
+     * @return True if some value was not present.
+     */
+    bool insert(const CountingSet& other) {
+        if (other.size() == 1) { return insert(other.min()); }
+        if (other.empty()) { return false; }
+        if (empty()) { *this = other; return true; }
+
+        // Merge from the largest values, in the order of the keys.
+        std::vector<CounterValue> merged{};
+        merged.reserve(size() + other.size());
+        bool changed{ false };
+        size_t i{ size() }, j{ other.size() };
+        while (i > 0 || j > 0) {
+            if (j == 0 || (i > 0 && (*this)[i - 1] > other[j - 1])) {
+                merged.push_back((*this)[--i] - offset_);
+            } else {
+                if (i == 0 || (*this)[i - 1] != other[j - 1]) { changed = true; }
+                else { --i; }
+                merged.push_back(other[--j] - offset_);
+            }
+        }
+        keys_ = std::move(merged);
+        head_ = 0;
+        return changed;
+    }
+
+    /// Insert all values of @p other, taking over its storage if it is the larger set.
+    bool insert(CountingSet&& other) {
+        if (other.size() <= size()) { return insert(other); }
+        // The union differs from the smaller original set.
+        std::swap(*this, other);
+        insert(other);
+        return true;
+    }
+
+    /// Replace all values greater than @p limit by @p limit.
+    void saturate(const CounterValue limit) {
+        if (empty() || max() <= limit) { return; }
+        while (!empty() && max() >= limit) { ++head_; }
+        keys_[--head_] = limit - offset_;
+        compact();
+    }
+
+    void clear() {
+        keys_.clear();
+        head_ = 0;
+        offset_ = 0;
+    }
+
+    /// Call @p function on all values in increasing order.
+    template<class Function>
+    void forEach(Function&& function) const {
+        for (size_t index{ keys_.size() }; index > head_; --index) { function(keys_[index - 1] + offset_); }
+    }
+
+    bool operator==(const CountingSet& other) const {
+        if (size() != other.size()) { return false; }
+        for (size_t index{ 0 }; index < size(); ++index) {
+            if ((*this)[index] != other[index]) { return false; }
+        }
+        return true;
+    }
+
+private:
+    /// Index (in the increasing order) of the first value not smaller than @p value.
+    size_t lowerBound(const CounterValue value) const {
+        size_t low{ 0 }, high{ size() };
+        while (low < high) {
+            const size_t middle{ low + (high - low) / 2 };
+            if ((*this)[middle] < value) { low = middle + 1; }
+            else { high = middle; }
+        }
+        return low;
+    }
+    /// Index (in the increasing order) of the first value greater than @p value.
+    size_t upperBound(const CounterValue value) const {
+        return value == std::numeric_limits<CounterValue>::max() ? size() : lowerBound(value + 1);
+    }
+
+    /// Drop the keys of removed largest values once they make up most of the storage.
+    void compact() {
+        if (head_ > size()) {
+            keys_.erase(keys_.begin(), keys_.begin() + static_cast<long>(head_));
+            head_ = 0;
+        }
+    }
+
+    /// Values minus @c offset_ (modulo the range of @c CounterValue) in decreasing order of the values. The smallest
+    ///  value, where new values usually enter, is at the back; the largest values are dropped by moving @c head_.
+    std::vector<CounterValue> keys_{};
+    size_t head_{ 0 }; ///< Number of dropped keys at the front of @c keys_.
+    CounterValue offset_{ 0 };
+};
+
+} // namespace mata::nfa.
+
+#endif // COUNTING_SET_HH
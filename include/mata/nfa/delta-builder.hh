@@ -0,0 +1,68 @@
+#ifndef DELTA_BUILDER_HH
+#define DELTA_BUILDER_HH
+
+#include <vector>
+
+#include "delta.hh"
+
+namespace mata::nfa {
+
+/**
+ * Bulk construction of @c Delta.
+ *
+ * Transitions are collected unsorted and with duplicates, then sorted and deduplicated in a single pass by
+ *  @c build(), which emits a @c Delta with exactly sized vectors. This avoids the shifting of elements in
+ *  @c Delta::add() when transitions do not arrive in order.
+ *
+ * When the source, symbol and target of every transition fit together into 64 bits, the transitions are packed into
+ *  64-bit keys and sorted by LSD radix sort. Otherwise, they are sorted by a comparison sort. Transitions added in
+ *  strictly increasing order are emitted directly, without sorting.
+ */
+class DeltaBuilder {
+public:
+    DeltaBuilder() = default;
+
+    /// Reserve space for @p num_of_transitions transitions.
+    void reserve(size_t num_of_transitions) { transitions_.reserve(num_of_transitions); }
+
+    void add(State source, Symbol symbol, State target) {
+        const Transition transition{ source, symbol, target };
+        sorted_ = sorted_ && (transitions_.empty() || transitions_.back() < transition);
+        transitions_.push_back(transition);
+        max_state_ = std::max({ max_state_, source, target });
+        max_symbol_ = std::max(max_symbol_, symbol);
+    }
+    void add(State source, Symbol symbol, const StateSet& targets) {
+        for (const State target : targets) { add(source, symbol, target); }
+    }
+
+    /// Number of collected transitions (including duplicates).
+    size_t size() const { return transitions_.size(); }
+    bool empty() const { return transitions_.empty(); }
+
+    /**
+     * Build the delta from the collected transitions and clear the builder.
+     * @param[in] num_of_states Minimal number of states of the resulting delta.
+     * @param[in] resource Memory resource to build the delta into.
+     */
+    Delta build(size_t num_of_states = 0, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+private:
+    struct Transition {
+        State source;
+        Symbol symbol;
+        State target;
+
+        auto operator<=>(const Transition&) const = default;
+    };
+
+    std::vector<Transition> transitions_{};
+    State max_state_{ 0 };
+    Symbol max_symbol_{ 0 };
+    /// Whether the transitions were added strictly ordered (e.g. read from a file written from a delta).
+    bool sorted_{ true };
+};
+
+} // namespace mata::nfa.
+
+#endif // DELTA_BUILDER_HH
@@ -10,13 +10,36 @@
 #ifndef DELTA_HH
 #define DELTA_HH
 
+#include <cassert>
+#include <memory_resource>
+#include <span>
 #include <vector>
 
+#include "mata/utils/memory-usage.hh"
 #include "mata/utils/ord-vector.hh"
+#include "mata/utils/sparse-set.hh"
 #include "types.hh"
 
 namespace mata::nfa {
 
+/// Heap memory of transitions by component, see @c Delta::memoryUsage().
+struct DeltaMemoryUsage {
+    utils::MemoryUsage state_posts{}; ///< The vector of the state posts.
+    utils::MemoryUsage symbol_posts{}; ///< Buffers of state posts with more symbol posts than stored inline.
+    utils::MemoryUsage targets{}; ///< Buffers of target sets with more targets than stored inline.
+    utils::MemoryUsage epsilon_closures{}; ///< The epsilon closure index.
+
+    utils::MemoryUsage total() const { return state_posts + symbol_posts + targets + epsilon_closures; }
+
+    DeltaMemoryUsage& operator+=(const DeltaMemoryUsage& other) {
+        state_posts += other.state_posts;
+        symbol_posts += other.symbol_posts;
+        targets += other.targets;
+        epsilon_closures += other.epsilon_closures;
+        return *this;
+    }
+};
+
 // TODO: Add description.
 class SymbolPost {
 public:
@@ -26,32 +49,57 @@ public:
     SymbolPost() = default;
     explicit SymbolPost(Symbol symbol) : symbol{ symbol }, targets{} {}
     SymbolPost(Symbol symbol, State target) : symbol{ symbol }, targets{ target } {}
+    SymbolPost(Symbol symbol, const Target& target) : symbol{ symbol }, targets{} { targets.push_back(target); }
     SymbolPost(Symbol symbol, StateSet targets) : symbol{ symbol }, targets{ std::move(targets) } {}
 
     SymbolPost(SymbolPost&& rhs) noexcept : symbol{ rhs.symbol }, targets{ std::move(rhs.targets) } {}
     SymbolPost(const SymbolPost& rhs) = default;
+
+    // Allocator-extended constructors used by the containers of Delta to place the targets in its memory resource.
+    using allocator_type = TargetSet::allocator_type;
+    explicit SymbolPost(const allocator_type& allocator) : symbol{}, targets(allocator) {}
+    SymbolPost(Symbol symbol, const allocator_type& allocator) : symbol{ symbol }, targets(allocator) {}
+    SymbolPost(Symbol symbol, State target, const allocator_type& allocator) : symbol{ symbol }, targets(allocator) {
+        targets.push_back(target);
+    }
+    SymbolPost(Symbol symbol, const StateSet& targets, const allocator_type& allocator);
+    SymbolPost(const SymbolPost& rhs, const allocator_type& allocator)
+        : symbol{ rhs.symbol }, targets(rhs.targets, allocator) {}
+    SymbolPost(SymbolPost&& rhs, const allocator_type& allocator)
+        : symbol{ rhs.symbol }, targets(std::move(rhs.targets), allocator) {}
+
     SymbolPost& operator=(SymbolPost&& rhs) noexcept;
     SymbolPost& operator=(const SymbolPost& rhs) = default;
 
     std::weak_ordering operator<=>(const SymbolPost& other) const { return symbol <=> other.symbol; }
     bool operator==(const SymbolPost& other) const { return symbol == other.symbol; }
 
-    void insert(State state);
+    void insert(const Target& target);
     void insert(const StateSet& states);
 };
 
+// Number of symbol posts stored inline in a state post; states with more outgoing symbols spill to the heap.
+constexpr size_t STATE_POST_INLINE_CAPACITY{ 1 };
+
 // TODO: Add description.
-class StatePost : private utils::OrdVector<SymbolPost> {
+class StatePost : private utils::SmallOrdVector<SymbolPost, STATE_POST_INLINE_CAPACITY,
+                                                std::pmr::polymorphic_allocator<SymbolPost>> {
 private:
-    using super = utils::OrdVector<SymbolPost>;
+    using super = utils::SmallOrdVector<SymbolPost, STATE_POST_INLINE_CAPACITY,
+                                        std::pmr::polymorphic_allocator<SymbolPost>>;
 
 public:
+    using typename super::allocator_type;
+    using super::get_allocator;
     using super::OrdVector;
     using super::operator=;
     using super::operator==;
 
     StatePost(const StatePost&) = default;
     StatePost(StatePost&&) = default;
+    explicit StatePost(const allocator_type& allocator) : super(allocator) {}
+    StatePost(const StatePost& other, const allocator_type& allocator) : super(other, allocator) {}
+    StatePost(StatePost&& other, const allocator_type& allocator) : super(std::move(other), allocator) {}
     StatePost& operator=(const StatePost&) = default;
     StatePost& operator=(StatePost&&) = default;
     bool operator==(const StatePost&) const = default;
@@ -62,21 +110,62 @@ public:
     using super::empty;
     using super::back;
     using super::find;
-
-    iterator find(const Symbol symbol) { return super::find({ symbol, {} }); }
-    const_iterator find(const Symbol symbol) const { return super::find({ symbol, {} }); }
+    using super::size;
+    using super::reserve;
+    // Note: Appending breaks sortedness when used carelessly, it is meant for bulk construction (see DeltaBuilder).
+    using super::push_back;
+    using super::emplace_back;
+
+    /// Heap memory of the symbol posts and their target sets (@c state_posts and @c epsilon_closures are zero).
+    DeltaMemoryUsage memoryUsage() const;
+    /// Release the capacity beyond the size of the symbol posts and of their target sets.
+    void shrinkToFit();
+
+    iterator find(const Symbol symbol) {
+        utils::stats::add(&utils::stats::Stats::symbol_searches);
+        return super::find({ symbol, {} });
+    }
+    const_iterator find(const Symbol symbol) const {
+        utils::stats::add(&utils::stats::Stats::symbol_searches);
+        return super::find({ symbol, {} });
+    }
 };
 
-// TODO: Add description.
+/**
+ * Transition relation: the state post of every state.
+ *
+ * All storage of the transitions (state posts, symbol posts and target sets) is obtained from the memory resource
+ *  passed on construction, @c std::pmr::get_default_resource() by default. Building a Delta into an arena (e.g.,
+ *  @c std::pmr::monotonic_buffer_resource) replaces the many small allocations with a few large ones and frees the
+ *  whole automaton at once when the arena is released. Copies of a Delta use the default resource.
+ */
 class Delta {
 private:
-    std::vector<StatePost> state_posts_;
+    std::pmr::vector<StatePost> state_posts_;
+
+    /// @brief Epsilon closures of all states in compressed sparse row form.
+    ///
+    /// The closure of state @c q is stored (sorted, including @c q itself) in
+    ///  @c epsilon_closure_states_[epsilon_closure_offsets_[q] .. epsilon_closure_offsets_[q + 1]).
+    /// The index is built by @c computeEpsilonClosures() (called by @c Nfa::freeze()), never by const methods, and
+    ///  invalidated by any change of epsilon transitions or of the number of states.
+    std::vector<size_t> epsilon_closure_offsets_{};
+    std::vector<State> epsilon_closure_states_{};
+    bool epsilon_closures_valid_{ false };
+
+    void invalidateEpsilonClosures() { epsilon_closures_valid_ = false; }
+    /// Extend @p states by following the epsilon transitions, without the closure index.
+    void searchEpsilonClosure(utils::SparseSet<State>& states) const;
+
+    friend class DeltaBuilder;
 
 public:
     Delta(): state_posts_{} {}
     Delta(const Delta& other) = default;
     Delta(Delta&& other) = default;
-    explicit Delta(size_t n): state_posts_{ n } {}
+    explicit Delta(size_t n, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : state_posts_(n, resource) {}
+    explicit Delta(std::pmr::memory_resource* resource): state_posts_{ resource } {}
 
     Delta& operator=(const Delta& other) = default;
     Delta& operator=(Delta&& other) = default;
@@ -84,10 +173,56 @@ public:
     bool operator==(const Delta& other) const;
 
     void add(State source, Symbol symbol, State target);
+    /// Add a transition whose target carries the annotations @c Theta[annotation_id].
+    void add(State source, Symbol symbol, State target, size_t annotation_id);
     void add(const State source, const Symbol symbol, const StateSet& targets);
 
     // bool contains(State source, Symbol symbol, State target) const;
+    size_t numStates() const { return state_posts_.size(); }
+    /// Memory resource providing the storage of the transitions.
+    std::pmr::memory_resource* getMemoryResource() const { return state_posts_.get_allocator().resource(); }
     const StatePost& getStatePost(State state) const { return state_posts_[state]; }
+
+    /// Whether the epsilon closure index is built and up to date.
+    bool hasEpsilonClosures() const { return epsilon_closures_valid_; }
+
+    /**
+     * Get the epsilon closure of @p state from the closure index: all states reachable over epsilon transitions,
+     *  including @p state itself.
+     * @pre @c hasEpsilonClosures() and @p state < @c numStates().
+     */
+    std::span<const State> getEpsilonClosure(State state) const {
+        assert(epsilon_closures_valid_);
+        return { epsilon_closure_states_.data() + epsilon_closure_offsets_[state],
+                 epsilon_closure_states_.data() + epsilon_closure_offsets_[state + 1] };
+    }
+
+    /**
+     * Extend @p states with all states reachable from them over epsilon transitions.
+     *
+     * Uses the closure index if it is built, otherwise follows the epsilon transitions. The Delta is only read, so
+     *  a shared Delta can be used from several threads.
+     */
+    void epsilonClosure(utils::SparseSet<State>& states) const;
+
+    /// Build the epsilon closure index (if not up to date).
+    void computeEpsilonClosures();
+
+    /**
+     * Heap memory of the transitions by component, including the capacity reserved but not used yet.
+     *
+     * Blocks are counted as requested from the memory resource of the delta; an arena may hold more.
+     */
+    DeltaMemoryUsage memoryUsage() const;
+
+    /**
+     * Release the capacity reserved beyond the size of all vectors (e.g., by @c reserve_on_insert when transitions
+     *  are added one by one), moving target sets and state posts back inline when they fit.
+     *
+     * A delta built by @c DeltaBuilder is already exactly sized. Memory released to an arena is reused only by the
+     *  arena.
+     */
+    void shrinkToFit();
 };
 
 } // namespace mata::nfa.
@@ -0,0 +1,168 @@
+#ifndef FROZEN_DELTA_HH
+#define FROZEN_DELTA_HH
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "delta.hh"
+
+namespace mata::nfa {
+
+/**
+ * Read-only transition relation packed into flat arrays (compressed sparse row).
+ *
+ * Transitions from state @c q are the symbol posts @c state_offsets[q] .. @c state_offsets[q + 1] - 1. Symbol post
+ *  @c i is labelled by @c symbols[i] and its targets are @c targets[target_offsets[i] .. target_offsets[i + 1]).
+ * A lookup therefore touches a few contiguous arrays instead of three levels of separately allocated vectors.
+ *
+ * The arrays are only viewed; they are kept alive by a shared storage (the vectors built from a @c Delta, or a mapped
+ *  file, see serialization.hh), so copies of a frozen delta share them.
+ *
+ * States with many outgoing symbol posts over byte symbols additionally get a dense table of @c BYTE_ALPHABET_SIZE
+ *  slots mapping a symbol directly to its symbol post, so the lookup is a single array access instead of a binary
+ *  search. Symbols outside of the byte range are still searched for.
+ *
+ * Target annotations are not kept, the frozen delta is meant for plain (counter-free) matching.
+ */
+class FrozenDelta {
+public:
+    /// Transitions from a state over a single symbol.
+    struct SymbolPost {
+        Symbol symbol;
+        std::span<const State> targets;
+    };
+
+    /// Transitions from a single state. Mirrors the iteration and lookup interface of @c StatePost.
+    class StatePost {
+    public:
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = SymbolPost;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = SymbolPost;
+
+            const_iterator() = default;
+            const_iterator(const FrozenDelta* delta, size_t index) : delta_{ delta }, index_{ index } {}
+
+            // Note: Dereferencing creates a view by value, there is intentionally no operator->.
+            SymbolPost operator*() const { return delta_->getSymbolPost(index_); }
+            const_iterator& operator++() { ++index_; return *this; }
+            const_iterator operator++(int) { const_iterator tmp{ *this }; ++index_; return tmp; }
+            bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+
+        private:
+            const FrozenDelta* delta_{ nullptr };
+            size_t index_{ 0 };
+        };
+        using iterator = const_iterator;
+
+        StatePost(const FrozenDelta* delta, size_t first, size_t last) : delta_{ delta }, first_{ first }, last_{ last } {}
+
+        const_iterator begin() const { return { delta_, first_ }; }
+        const_iterator end() const { return { delta_, last_ }; }
+        bool empty() const { return first_ == last_; }
+        size_t size() const { return last_ - first_; }
+
+        /// Find the symbol post over @p symbol, @c end() if there is none.
+        const_iterator find(Symbol symbol) const {
+            utils::stats::add(&utils::stats::Stats::symbol_searches);
+            if (dense_ != nullptr && symbol < BYTE_ALPHABET_SIZE) {
+                if (dense_[symbol] == NO_DENSE_SLOT) { return end(); }
+                return { delta_, first_ + dense_[symbol] };
+            }
+            return { delta_, delta_->findSymbolPost(first_, last_, symbol) };
+        }
+
+    private:
+        const FrozenDelta* delta_;
+        size_t first_;
+        size_t last_;
+        /// Dense table of the state, @c nullptr if the state has none.
+        const uint16_t* dense_{ nullptr };
+
+        friend class FrozenDelta;
+    };
+
+    static constexpr size_t BYTE_ALPHABET_SIZE{ 256 };
+    /// States with at least this many symbol posts over byte symbols get a dense table.
+    static constexpr size_t DEFAULT_DENSE_THRESHOLD{ 16 };
+    static constexpr uint32_t NO_DENSE_TABLE{ std::numeric_limits<uint32_t>::max() };
+    static constexpr uint16_t NO_DENSE_SLOT{ std::numeric_limits<uint16_t>::max() };
+
+    /// The flat arrays of a frozen delta.
+    struct Arrays {
+        std::span<const size_t> state_offsets{};
+        std::span<const Symbol> symbols{};
+        std::span<const size_t> target_offsets{};
+        std::span<const State> targets{};
+
+        std::span<const size_t> epsilon_closure_offsets{};
+        std::span<const State> epsilon_closure_states{};
+
+        /// Dense tables of states: slot @c symbol of the table of state @c q is
+        ///  @c dense_slots[dense_table_of_state[q] * BYTE_ALPHABET_SIZE + symbol] and holds the offset of the symbol
+        ///  post relative to @c state_offsets[q] (@c NO_DENSE_SLOT if @c q has no transition over @c symbol).
+        std::span<const uint32_t> dense_table_of_state{};
+        std::span<const uint16_t> dense_slots{};
+    };
+
+    FrozenDelta() = default;
+    explicit FrozenDelta(const Delta& delta, size_t dense_threshold = DEFAULT_DENSE_THRESHOLD);
+    /// View @p arrays in place, kept alive by @p storage. The arrays are trusted to be consistent.
+    FrozenDelta(const Arrays& arrays, std::shared_ptr<const void> storage)
+        : storage_{ std::move(storage) }, arrays_{ arrays } {}
+
+    const Arrays& arrays() const { return arrays_; }
+
+    size_t numStates() const { return arrays_.state_offsets.empty() ? 0 : arrays_.state_offsets.size() - 1; }
+    size_t numSymbolPosts() const { return arrays_.symbols.size(); }
+    size_t numTransitions() const { return arrays_.targets.size(); }
+    size_t numDenseStates() const { return arrays_.dense_slots.size() / BYTE_ALPHABET_SIZE; }
+    bool isDense(State state) const { return arrays_.dense_table_of_state[state] != NO_DENSE_TABLE; }
+
+    /// Memory of the arrays (exactly sized). The arrays of a delta viewing a mapped file are the pages of the file.
+    utils::MemoryUsage memoryUsage() const {
+        return { arrays_.state_offsets.size_bytes() + arrays_.symbols.size_bytes()
+                     + arrays_.target_offsets.size_bytes() + arrays_.targets.size_bytes()
+                     + arrays_.epsilon_closure_offsets.size_bytes() + arrays_.epsilon_closure_states.size_bytes()
+                     + arrays_.dense_table_of_state.size_bytes() + arrays_.dense_slots.size_bytes(),
+                 0 };
+    }
+
+    StatePost getStatePost(State state) const {
+        StatePost state_post{ this, arrays_.state_offsets[state], arrays_.state_offsets[state + 1] };
+        if (const uint32_t table{ arrays_.dense_table_of_state[state] }; table != NO_DENSE_TABLE) {
+            state_post.dense_ = arrays_.dense_slots.data() + static_cast<size_t>(table) * BYTE_ALPHABET_SIZE;
+        }
+        return state_post;
+    }
+
+    /// The epsilon closures are always precomputed (see @c Delta::hasEpsilonClosures()).
+    bool hasEpsilonClosures() const { return true; }
+
+    /// Get the epsilon closure of @p state (including @p state itself). @pre @p state < @c numStates().
+    std::span<const State> getEpsilonClosure(State state) const {
+        return { arrays_.epsilon_closure_states.data() + arrays_.epsilon_closure_offsets[state],
+                 arrays_.epsilon_closure_states.data() + arrays_.epsilon_closure_offsets[state + 1] };
+    }
+
+private:
+    std::shared_ptr<const void> storage_{}; ///< Owner of the memory viewed by @c arrays_.
+    Arrays arrays_{};
+
+    SymbolPost getSymbolPost(size_t index) const {
+        return { arrays_.symbols[index], { arrays_.targets.data() + arrays_.target_offsets[index],
+                                           arrays_.targets.data() + arrays_.target_offsets[index + 1] } };
+    }
+
+    /// Index of the symbol post over @p symbol among symbol posts [@p first, @p last), @p last if not found.
+    size_t findSymbolPost(size_t first, size_t last, Symbol symbol) const;
+};
+
+} // namespace mata::nfa.
+
+#endif // FROZEN_DELTA_HH
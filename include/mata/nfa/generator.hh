@@ -0,0 +1,78 @@
+#ifndef GENERATOR_HH
+#define GENERATOR_HH
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nfa.hh"
+
+namespace mata::nfa {
+
+/// Distribution of the numbers of transitions leaving the states of a generated automaton.
+enum class DegreeDistribution {
+    Constant, ///< Every state has the mean out-degree (rounded).
+    Uniform, ///< Uniform on [0, 2 * mean].
+    Geometric, ///< Geometric with the given mean: many states with few transitions.
+    PowerLaw, ///< Pareto-like with the given mean: a few hub states with many transitions.
+};
+
+/// Parameters of a random automaton. Equal parameters (including the seed) give equal automata on every platform.
+struct GeneratorParameters {
+    uint64_t seed{ 0 };
+    size_t num_of_states{ 100 };
+    /// Symbols of the non-epsilon transitions are @c first_symbol, ..., @c first_symbol + @c alphabet_size - 1.
+    size_t alphabet_size{ 4 };
+    Symbol first_symbol{ 'a' };
+    double out_degree{ 2.0 }; ///< Mean number of transitions leaving a state.
+    DegreeDistribution distribution{ DegreeDistribution::Uniform };
+    double epsilon_density{ 0.0 }; ///< Probability that a transition is an epsilon transition.
+    double final_density{ 0.1 }; ///< Probability that a state is final; the last state is always final.
+    size_t num_of_counters{ 0 };
+    /// Probability that a transition is annotated (if there are counters). Annotations of epsilon transitions are
+    ///  tests only, so that epsilon cycles cannot change counters unboundedly.
+    double annotation_density{ 0.0 };
+    CounterValue max_bound{ 10 }; ///< Largest constant counters are compared with.
+    /// Whether annotations may decrement counters. Values of decremented counters are not saturated by
+    ///  @c Nfa::simulateWithCounters, so the number of configurations may grow with the length of the input.
+    bool decrements{ false };
+};
+
+/**
+ * Generate a random automaton with the initial state 0.
+ *
+ * Transitions go to uniformly chosen targets. Annotated transitions carry one of the patterns of counting
+ *  constraints: a counting step (test below a bound and increment), an exit (test at least a bound and reset),
+ *  a range test, a reset, an increment, or (if enabled) a guarded decrement.
+ */
+Nfa generateNfa(const GeneratorParameters& parameters);
+
+/// Parameters of a corpus of input words.
+struct CorpusParameters {
+    uint64_t seed{ 0 };
+    size_t num_of_words{ 100 };
+    size_t length{ 1000 }; ///< Minimal length of matching words; exact length of non-matching words.
+    /// Alphabet of the random non-matching words.
+    size_t alphabet_size{ 4 };
+    Symbol first_symbol{ 'a' };
+};
+
+/**
+ * Generate words accepted by @p nfa (executing its counter annotations, if any).
+ *
+ * Each word is read along a random run of at least @c length symbols, which then heads for the nearest final state.
+ *  Fewer words are returned if runs keep getting stuck (e.g. the automaton accepts no word of such a length).
+ */
+std::vector<std::string> generateMatchingWords(const Nfa& nfa, const CorpusParameters& parameters);
+
+/**
+ * Generate words of exactly @c length symbols rejected by @p nfa.
+ *
+ * Half of the candidates are uniformly random words, the other half are near misses: matching words with a symbol
+ *  changed or their end cut off. Fewer words are returned if too few candidates are rejected.
+ */
+std::vector<std::string> generateNonMatchingWords(const Nfa& nfa, const CorpusParameters& parameters);
+
+} // namespace mata::nfa.
+
+#endif // GENERATOR_HH
@@ -0,0 +1,89 @@
+#ifndef LAZY_DFA_HH
+#define LAZY_DFA_HH
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "nfa.hh"
+
+namespace mata::nfa {
+
+/**
+ * Lazy determinization of an NFA.
+ *
+ * Macrostates (epsilon-closed sets of NFA states) are created on the fly while simulating and each is interned
+ *  under a numeric ID. Successors of macrostates are cached in a table indexed by (macrostate, byte), so repeated
+ *  inputs run at DFA speed without building the whole subset automaton up front.
+ *
+ * The cache is bounded by a memory budget. When the budget would be exceeded, the whole cache is flushed and
+ *  determinization continues from the current macrostate.
+ *
+ * Note: The lazy DFA keeps a reference to the NFA, which must not be modified while the lazy DFA is in use.
+ */
+class LazyDfa {
+public:
+    using MacroState = size_t;
+
+    /// Statistics on the cache behaviour.
+    struct Stats {
+        size_t hits{ 0 }; ///< Successors found in the cache.
+        size_t misses{ 0 }; ///< Successors which had to be computed.
+        size_t flushes{ 0 }; ///< Number of times the cache was flushed because of the memory budget.
+    };
+
+    /// Input is read as bytes, so each macrostate has a row of this many successors.
+    static constexpr size_t ALPHABET_SIZE{ 256 };
+    static constexpr size_t DEFAULT_MEMORY_BUDGET{ 8 * 1024 * 1024 };
+
+    explicit LazyDfa(const Nfa& nfa, size_t memory_budget = DEFAULT_MEMORY_BUDGET);
+
+    LazyDfa(const LazyDfa&) = delete;
+    LazyDfa& operator=(const LazyDfa&) = delete;
+
+    /// Decide whether the NFA accepts @p input, reusing and extending the cache.
+    bool simulate(const std::string& input);
+
+    /// Drop all cached macrostates and successors.
+    void flush();
+
+    const Stats& getStats() const { return stats_; }
+    void resetStats() { stats_ = {}; }
+
+    size_t numMacroStates() const { return macrostates_.size(); }
+    /// Estimated number of bytes currently used by the cache.
+    size_t memoryUsed() const { return memory_used_; }
+    size_t memoryBudget() const { return memory_budget_; }
+
+private:
+    static constexpr MacroState UNKNOWN{ std::numeric_limits<MacroState>::max() };
+
+    const Nfa& nfa_;
+    size_t memory_budget_;
+    size_t memory_used_{ 0 };
+
+    /// Interned macrostates. Pointers to the keys of @c ids_ are stable.
+    std::unordered_map<StateSet, MacroState> ids_{};
+    std::vector<const StateSet*> macrostates_{};
+    BoolVector accepting_{};
+    /// Successors: @c successors_[macrostate * ALPHABET_SIZE + symbol], @c UNKNOWN if not computed yet.
+    std::vector<MacroState> successors_{};
+    MacroState initial_{ UNKNOWN };
+
+    utils::SparseSet<State> current_{};
+    utils::SparseSet<State> next_{};
+
+    Stats stats_{};
+
+    MacroState getInitial();
+    MacroState getSuccessor(MacroState macrostate, Symbol symbol);
+    /**
+     * Return the ID of @p states, creating a new macrostate if it is not known yet.
+     * May flush the cache, in which case all previously returned IDs are invalidated.
+     */
+    MacroState intern(StateSet&& states);
+};
+
+} // namespace mata::nfa.
+
+#endif // LAZY_DFA_HH
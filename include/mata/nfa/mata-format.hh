@@ -0,0 +1,58 @@
+#ifndef MATA_FORMAT_HH
+#define MATA_FORMAT_HH
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "nfa.hh"
+
+namespace mata::nfa {
+
+/**
+ * Reading and writing automata in the .mata text format of the Mata library, section @c @NFA-explicit:
+ *
+ * @code
+ * @NFA-explicit
+ * %Alphabet-numbers
+ * %Initial q0
+ * %Final q2
+ * q0 97 q1
+ * q1 98 q2
+ * @endcode
+ *
+ * - @c %Alphabet-numbers: symbols are decimal numbers, 0 is epsilon.
+ * - @c %Alphabet-chars and @c %Alphabet-auto (the default): symbols are single bytes, written as the byte itself or
+ *    as @c \xHH. Epsilon cannot be written.
+ * - States named @c qN or @c N are the state N. Other names are numbered in the order of their first occurrence,
+ *    after the largest numbered state.
+ * - Lines may contain comments starting by @c # at the start of a token. @c %States lines only list the states and
+ *    are skipped.
+ *
+ * The format is extended by counters: @c %Counters lists the initial values of the counters, and a transition may
+ *  be followed by @c | and its annotations: @c inc(c,n), @c dec(c,n), @c reset(c), @c eq(c,v), @c lt(c,v),
+ *  @c ge(c,v) and @c in(c,low,high), without spaces.
+ */
+
+/**
+ * Parse an automaton from @p text.
+ *
+ * The text is tokenized in place, without copying lines. Transitions without annotations are collected by
+ *  @c DeltaBuilder, so the delta is built in a single sort whatever the order of the lines.
+ * @throws std::runtime_error If the text is not a valid automaton (the message gives the line).
+ */
+Nfa parseMata(std::string_view text);
+
+/**
+ * Parse an automaton from the file at @p path, mapped into memory.
+ * @throws std::runtime_error If the file cannot be mapped or is not a valid automaton.
+ */
+Nfa loadMata(const std::string& path);
+
+/// Write @p nfa to @p output in the .mata format with numeric symbols, parsed back by @c parseMata() to an equal
+///  automaton (annotation IDs may differ).
+void writeMata(const Nfa& nfa, std::ostream& output);
+
+} // namespace mata::nfa.
+
+#endif // MATA_FORMAT_HH
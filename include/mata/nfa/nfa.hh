@@ -1,19 +1,69 @@
 #ifndef NFA_HH
 #define NFA_HH
 
+#include <optional>
+#include <ostream>
+#include <span>
 #include <string>
+#include <variant>
 
+#include "bit-parallel-delta.hh"
 #include "delta.hh"
+#include "frozen-delta.hh"
+#include "theta.hh"
 #include "../utils/sparse-set.hh"
 
 namespace mata::nfa {
 
+/// Heap memory of an automaton by component, see @c Nfa::memoryUsage().
+struct NfaMemoryUsage {
+    DeltaMemoryUsage delta{};
+    utils::MemoryUsage initial{}; ///< Domain arrays of the set of initial states.
+    utils::MemoryUsage final{}; ///< Domain arrays of the set of final states.
+    utils::MemoryUsage counters{};
+    utils::MemoryUsage theta{};
+    utils::MemoryUsage frozen_delta{}; ///< Frozen and bit-parallel deltas made by @c Nfa::freeze().
+
+    utils::MemoryUsage total() const { return delta.total() + initial + final + counters + theta + frozen_delta; }
+
+    /// Print the components, one per line.
+    void print(std::ostream& output) const {
+        output << "state posts: " << delta.state_posts << "\n"
+               << "symbol posts: " << delta.symbol_posts << "\n"
+               << "targets: " << delta.targets << "\n"
+               << "epsilon closures: " << delta.epsilon_closures << "\n"
+               << "initial states: " << initial << "\n"
+               << "final states: " << final << "\n"
+               << "counters: " << counters << "\n"
+               << "theta: " << theta << "\n"
+               << "frozen delta: " << frozen_delta << "\n"
+               << "total: " << total() << "\n";
+    }
+};
+
+/// The narrowest bit-parallel form of a frozen delta, if the automaton fits into any.
+using BitParallelDeltaVariant = std::variant<std::monostate, BitParallelDelta<1>, BitParallelDelta<2>,
+                                             BitParallelDelta<4>>;
+
+/// Compile @p delta of an automaton with @p num_of_states states for bit-parallel simulation, if it fits.
+BitParallelDeltaVariant makeBitParallelDelta(const FrozenDelta& delta, size_t num_of_states);
+
+/**
+ * Decide whether the automaton with the transitions @p delta accepts @p input, ignoring the counters.
+ *
+ * Uses @p bit_parallel_delta (compiled from @p delta) if all @p num_of_states states fit into it, the set-based
+ *  simulation over @p delta otherwise. Shared by @c Nfa::simulate() on a frozen automaton and @c MappedNfa.
+ */
+bool simulateFrozen(const FrozenDelta& delta, const BitParallelDeltaVariant& bit_parallel_delta, size_t num_of_states,
+                    std::span<const State> initial, std::span<const State> final, const std::string& input);
+
 // TODO: Add description.
 struct Nfa {
     Delta delta;
     utils::SparseSet<State> initial{};
     utils::SparseSet<State> final{};
     CounterSet counters{}; // Added CounterSet (CounterRegisterSet) member for NFA counters.
+    Theta theta{}; ///< Annotations of the transitions, referenced by @c AnnotationState::annotation_id of targets.
 
     Nfa() = default;
     Nfa(const Delta& delta,
@@ -21,13 +71,88 @@ struct Nfa {
         const utils::SparseSet<State>& final,
         const CounterSet& counters)
         : delta(delta), initial(initial), final(final), counters(counters) {}
+    // Takes over the delta together with its memory resource (a copy would use the default resource).
+    Nfa(Delta&& delta,
+        const utils::SparseSet<State>& initial,
+        const utils::SparseSet<State>& final,
+        const CounterSet& counters)
+        : delta(std::move(delta)), initial(initial), final(final), counters(counters) {}
 
     void addInitialState(State state);
     void addFinalState(State state);
+
+    /**
+     * Decide whether the NFA accepts @p input.
+     *
+     * Set-based (Thompson) simulation: the epsilon-closed set of active states is advanced one symbol at a time,
+     *  so the run takes O(|input| * |transitions|) time without recursion.
+     */
     bool simulate(const std::string& input) const;
 
+    /**
+     * Decide whether the NFA accepts @p input, executing the annotations in @c theta.
+     *
+     * The simulation tracks configurations (state, counter valuation), starting from the initial states with
+     *  @c counters. Taking a transition to a target with an annotation ID executes the annotations of @c theta:
+     *  a failing test (or a decrement below zero) disables the transition, other annotations update the valuation of
+     *  the new configuration.
+     *  Identical configurations are merged after each step, so the number of configurations is bounded by the number
+     *  of distinct reachable valuations, not by the values of the counters (counting constraints are not unrolled).
+     * The values of the counter tested from a state are kept in a @c CountingSet shared by all configurations of the
+     *  state that differ only in this counter, so counting loops such as .*a{n,m} take constant time per input symbol
+     *  independently of n and m. Counters that cannot be tested before being reset are ignored, and values above
+     *  the largest constant a counter is compared with are saturated (unless the counter is decremented).
+     * The input is accepted if a final state is reached with any valuation.
+     *
+     * Annotations on epsilon transitions are executed as well; cycles of epsilon transitions must not change
+     *  the counters unboundedly.
+     */
+    bool simulateWithCounters(const std::string& input) const;
+
+    /// Extend @p states with all states reachable from them over epsilon transitions.
+    void epsilonClosure(utils::SparseSet<State>& states) const;
+
+    /**
+     * Compute the epsilon-closed set of successors of @p states over @p symbol.
+     * @param[in] states Set of source states.
+     * @param[in] symbol Symbol to read.
+     * @param[out] result Successors; cleared before use.
+     */
+    void post(const utils::SparseSet<State>& states, Symbol symbol, utils::SparseSet<State>& result) const;
+
+    /// Number of states the simulation has to account for (states used in delta, initial or final).
+    size_t numStates() const;
+
+    /**
+     * Pack @c delta into a @c FrozenDelta used by all subsequent simulations.
+     *
+     * Unless @p bit_parallel is false, automata with at most @c MAX_BIT_PARALLEL_STATES states are additionally
+     *  compiled into a @c BitParallelDelta, which is then used for @c simulate() (as long as the initial and final
+     *  states fit into it as well).
+     *
+     * Call this once the construction of the automaton is done. Changes made to @c delta afterwards are not seen by
+     *  the simulation until @c freeze() is called again (or @c unfreeze() is called).
+     */
+    void freeze(bool bit_parallel = true);
+    /// Drop the frozen delta and simulate over @c delta again.
+    void unfreeze() {
+        frozen_delta_.reset();
+        bit_parallel_delta_ = std::monostate{};
+    }
+    bool isFrozen() const { return frozen_delta_.has_value(); }
+    /// Whether @c freeze() compiled the automaton for bit-parallel simulation.
+    bool isBitParallel() const { return !std::holds_alternative<std::monostate>(bit_parallel_delta_); }
+
+    static constexpr size_t MAX_BIT_PARALLEL_STATES{ BitParallelDelta<4>::MAX_NUM_OF_STATES };
+
+    /// Heap memory of the automaton by component, see @c NfaMemoryUsage.
+    NfaMemoryUsage memoryUsage() const;
+    /// Release the capacity reserved beyond the size of all containers (see @c Delta::shrinkToFit()).
+    void shrinkToFit();
+
 private:
-    bool simulateRecursive(State currentState, const std::string& input, size_t index) const;
+    std::optional<FrozenDelta> frozen_delta_{};
+    BitParallelDeltaVariant bit_parallel_delta_{};
 };
 
 } // namespace mata::nfa.
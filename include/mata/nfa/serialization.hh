@@ -0,0 +1,92 @@
+#ifndef SERIALIZATION_HH
+#define SERIALIZATION_HH
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+#include "nfa.hh"
+
+namespace mata::nfa {
+
+/**
+ * Binary format of automata, loaded by mapping the file into memory and used in place.
+ *
+ * The file starts with a header (magic "MATANFA", format version, byte order and sizes of the stored types, file
+ *  size and a table of sections), followed by sections aligned to @c SECTION_ALIGNMENT bytes. The sections are the
+ *  flat arrays of @c FrozenDelta, the annotation IDs of the targets, the initial and final states, the initial values
+ *  of the counters and the annotations of @c Theta. All positions are offsets from the start of the file, so the
+ *  file can be mapped at any address and shared read-only by several processes.
+ *
+ * Values are stored in the native byte order with the native sizes of the types; a file written on a machine with
+ *  a different byte order or type sizes is rejected when loaded.
+ */
+constexpr uint32_t NFA_FORMAT_VERSION{ 1 };
+constexpr size_t SECTION_ALIGNMENT{ 64 };
+
+/**
+ * Write @p nfa to the file at @p path in the binary format.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void saveNfa(const Nfa& nfa, const std::string& path);
+
+/**
+ * Automaton mapped from a file in the binary format (see @c saveNfa()).
+ *
+ * Loading maps the file and checks the header, the bounds of the sections and every offset, state, annotation
+ *  ID and counter ID stored in them (one pass over the arrays, so that a corrupt file cannot cause reads out of the
+ *  mapping). The arrays are then used in place without being parsed or copied. The mapping is released when the
+ *  last copy of the automaton (or of its delta) is destroyed.
+ */
+class MappedNfa {
+public:
+    /// @throws std::runtime_error If the file cannot be mapped or is not a valid file of the current format.
+    explicit MappedNfa(const std::string& path);
+
+    const FrozenDelta& delta() const { return delta_; }
+    /// Annotation IDs of the targets, in the order of @c delta().arrays().targets (@c UNDEFINED_ID if none).
+    std::span<const size_t> targetAnnotationIds() const { return target_annotation_ids_; }
+    /// Initial states, sorted.
+    std::span<const State> initial() const { return initial_; }
+    /// Final states, sorted.
+    std::span<const State> final() const { return final_; }
+    /// Initial values of the counters.
+    std::span<const CounterValue> counters() const { return counters_; }
+    /// Number of groups of annotations (as in @c Theta).
+    size_t numAnnotationGroups() const { return annotation_offsets_.size() - 1; }
+    /// Annotations of the group @p annotation_id.
+    std::span<const Annotation> annotations(const size_t annotation_id) const {
+        return { annotations_.data() + annotation_offsets_[annotation_id],
+                 annotations_.data() + annotation_offsets_[annotation_id + 1] };
+    }
+
+    /// Number of states the simulation has to account for (states of the delta, initial or final states).
+    size_t numStates() const;
+
+    /// Decide whether the automaton accepts @p input, ignoring the counters (as @c Nfa::simulate() on a frozen
+    ///  automaton, bit-parallel if the automaton is small enough).
+    bool simulate(const std::string& input) const {
+        return simulateFrozen(delta_, bit_parallel_delta_, numStates(), initial_, final_, input);
+    }
+    /// Whether the automaton was compiled for bit-parallel simulation when loaded.
+    bool isBitParallel() const { return !std::holds_alternative<std::monostate>(bit_parallel_delta_); }
+
+    /// Copy the automaton into an @c Nfa (e.g., to modify it or to simulate it with counters).
+    Nfa toNfa() const;
+
+private:
+    std::shared_ptr<const void> mapping_{};
+    FrozenDelta delta_{};
+    BitParallelDeltaVariant bit_parallel_delta_{};
+    std::span<const size_t> target_annotation_ids_{};
+    std::span<const State> initial_{};
+    std::span<const State> final_{};
+    std::span<const CounterValue> counters_{};
+    std::span<const size_t> annotation_offsets_{};
+    std::span<const Annotation> annotations_{};
+};
+
+} // namespace mata::nfa.
+
+#endif // SERIALIZATION_HH
@@ -0,0 +1,240 @@
+#ifndef THETA_HH
+#define THETA_HH
+
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "types.hh"
+
+namespace mata::nfa {
+
+/// Compact record of a single transition annotation: an operation on a counter.
+struct Annotation {
+    enum class Opcode : uint8_t {
+        Increment, ///< Add @c operand to the counter.
+        Decrement, ///< Subtract @c operand from the counter.
+        Reset, ///< Set the counter to its initial value.
+        TestEqual, ///< Guard: the counter equals @c operand.
+        TestLess, ///< Guard: the counter is less than @c operand.
+        TestGreaterEqual, ///< Guard: the counter is at least @c operand.
+        TestInRange, ///< Guard: the counter lies in [@c operand, @c upper].
+    };
+
+    Opcode opcode;
+    uint32_t counter_id; ///< The ID of the counter (index in the CounterSet).
+    CounterValue operand;
+    CounterValue upper{ 0 }; ///< Inclusive upper bound of @c TestInRange, unused otherwise.
+
+    static Annotation increment(size_t counter_id, CounterValue amount = 1) {
+        return make(Opcode::Increment, counter_id, amount);
+    }
+    static Annotation decrement(size_t counter_id, CounterValue amount = 1) {
+        return make(Opcode::Decrement, counter_id, amount);
+    }
+    static Annotation reset(size_t counter_id) { return make(Opcode::Reset, counter_id, 0); }
+    static Annotation testEqual(size_t counter_id, CounterValue value) {
+        return make(Opcode::TestEqual, counter_id, value);
+    }
+    static Annotation testLess(size_t counter_id, CounterValue value) {
+        return make(Opcode::TestLess, counter_id, value);
+    }
+    static Annotation testGreaterEqual(size_t counter_id, CounterValue value) {
+        return make(Opcode::TestGreaterEqual, counter_id, value);
+    }
+    static Annotation testInRange(size_t counter_id, CounterValue low, CounterValue high) {
+        Annotation annotation{ make(Opcode::TestInRange, counter_id, low) };
+        annotation.upper = high;
+        return annotation;
+    }
+
+    /// Whether the annotation is a guard (it does not change the counter).
+    bool isTest() const { return opcode >= Opcode::TestEqual; }
+
+    bool operator==(const Annotation&) const = default;
+
+    /// Range [low, high] of values passing the test (an empty range has low > high). The annotation must be a test.
+    std::pair<CounterValue, CounterValue> testedRange() const {
+        switch (opcode) {
+            case Opcode::TestEqual: return { operand, operand };
+            case Opcode::TestLess:
+                return operand == 0 ? std::pair<CounterValue, CounterValue>{ 1, 0 }
+                                    : std::pair<CounterValue, CounterValue>{ 0, operand - 1 };
+            case Opcode::TestGreaterEqual: return { operand, std::numeric_limits<CounterValue>::max() };
+            case Opcode::TestInRange: return { operand, upper };
+            default: assert(false); return { 0, std::numeric_limits<CounterValue>::max() };
+        }
+    }
+
+private:
+    static Annotation make(Opcode opcode, size_t counter_id, CounterValue operand) {
+        assert(counter_id <= std::numeric_limits<uint32_t>::max());
+        return { opcode, static_cast<uint32_t>(counter_id), operand, 0 };
+    }
+};
+
+/**
+ * Guard of a transition: the value of a counter before the transition must lie in [low, high].
+ *
+ * Tests of all kinds reduce to a range, so a batch of values is checked by the same two comparisons per value.
+ */
+struct Guard {
+    uint32_t counter_id;
+    CounterValue low;
+    CounterValue high;
+
+    bool test(const CounterValue value) const { return (value >= low) & (value <= high); }
+
+    /**
+     * Test the values @p values[0 .. size) of the counter in a batch of configurations.
+     * @param[in,out] passed Cleared at the indices of the values failing the test.
+     */
+    void test(const CounterValue* values, const size_t size, uint8_t* passed) const {
+        const CounterValue guard_low{ low }, guard_high{ high };
+        for (size_t i{ 0 }; i < size; ++i) {
+            passed[i] &= static_cast<uint8_t>((values[i] >= guard_low) & (values[i] <= guard_high));
+        }
+    }
+};
+
+/**
+ * Annotations of transitions, the counterpart of @c Delta for counters.
+ *
+ * Targets of transitions refer to a group of annotations by @c AnnotationState::annotation_id. The annotations of
+ *  group @c i are stored contiguously as @c annotations_[offsets_[i] .. offsets_[i + 1]).
+ *
+ * When a group is added, its tests are compiled into guards on the values of the counters before the transition
+ *  (a test following an increment by k becomes a test shifted by k; a decrement implies that the counter is large
+ *  enough), so that a transition can be ruled out for many configurations at once before anything is executed.
+ *  The remaining actions (and the tests of counters after their reset, which do not depend on the values before the
+ *  transition) are then executed in order by a switch over their opcodes, without any virtual call.
+ *
+ * The guards assume exact arithmetic, where an operation leaving the range of values fails (@c CheckedArithmetic).
+ *  Counters with other arithmetic policies (wrapping, saturating or bounded) execute the annotations in order instead.
+ */
+class Theta {
+public:
+    /// Whether the compiled guards and actions are equivalent to the annotations for registers in @p RegisterSet.
+    template<class RegisterSet>
+    static constexpr bool COMPILED_FOR = std::is_same_v<typename RegisterSet::Register::ArithmeticType,
+                                                        CheckedArithmetic<typename RegisterSet::Register::ValueType>>;
+
+    Theta() = default;
+
+    /// Append a group of annotations and return its ID (to be used as @c AnnotationState::annotation_id).
+    size_t add(std::span<const Annotation> annotations);
+    size_t add(std::initializer_list<Annotation> annotations) {
+        return add(std::span<const Annotation>{ annotations.begin(), annotations.size() });
+    }
+
+    /// Annotations of the group @p annotation_id.
+    std::span<const Annotation> operator[](const size_t annotation_id) const {
+        assert(annotation_id < size());
+        return { annotations_.data() + offsets_[annotation_id], annotations_.data() + offsets_[annotation_id + 1] };
+    }
+
+    /// Guards of the group @p annotation_id, at most one per counter.
+    std::span<const Guard> guards(const size_t annotation_id) const {
+        assert(annotation_id < size());
+        return { guards_.data() + guard_offsets_[annotation_id], guards_.data() + guard_offsets_[annotation_id + 1] };
+    }
+    /// Annotations of the group @p annotation_id executed after its guards pass.
+    std::span<const Annotation> actions(const size_t annotation_id) const {
+        assert(annotation_id < size());
+        return { actions_.data() + action_offsets_[annotation_id],
+                 actions_.data() + action_offsets_[annotation_id + 1] };
+    }
+
+    /// Number of groups of annotations.
+    size_t size() const { return offsets_.size() - 1; }
+    bool empty() const { return size() == 0; }
+    /// Total number of annotations in all groups.
+    size_t numAnnotations() const { return annotations_.size(); }
+
+    /// Heap memory of the annotations and of the compiled guards and actions.
+    utils::MemoryUsage memoryUsage() const {
+        return utils::vector_memory_usage(offsets_) + utils::vector_memory_usage(annotations_)
+               + utils::vector_memory_usage(guard_offsets_) + utils::vector_memory_usage(guards_)
+               + utils::vector_memory_usage(action_offsets_) + utils::vector_memory_usage(actions_);
+    }
+    void shrinkToFit() {
+        offsets_.shrink_to_fit();
+        annotations_.shrink_to_fit();
+        guard_offsets_.shrink_to_fit();
+        guards_.shrink_to_fit();
+        action_offsets_.shrink_to_fit();
+        actions_.shrink_to_fit();
+    }
+
+    /// Whether the group @p annotation_id can be executed on @p counters: whether they pass its guards, or with
+    ///  arithmetic other than @c CheckedArithmetic, whether executing it on a copy of @p counters succeeds.
+    template<class RegisterSet = CounterSet>
+    bool test(const size_t annotation_id, const RegisterSet& counters) const {
+        if constexpr (COMPILED_FOR<RegisterSet>) {
+            for (const Guard& guard : guards(annotation_id)) {
+                assert(guard.counter_id < counters.size());
+                if (!guard.test(counters[guard.counter_id].value)) { return false; }
+            }
+            return true;
+        } else {
+            RegisterSet updated{ counters };
+            return execute(annotation_id, updated);
+        }
+    }
+
+    /**
+     * Execute the annotations of the group @p annotation_id on @p counters, in order.
+     *
+     * Works with registers of any width and arithmetic policy (see counter.hh). The compiled guards and actions are
+     *  used with @c CheckedArithmetic, the annotations themselves in order with the other policies.
+     * @return False if a test fails or the arithmetic policy of a register rejects an operation (the transition
+     *  cannot be taken; @p counters are then partially updated).
+     */
+    template<class RegisterSet = CounterSet>
+    bool execute(const size_t annotation_id, RegisterSet& counters) const {
+        if constexpr (COMPILED_FOR<RegisterSet>) {
+            if (!test(annotation_id, counters)) { return false; }
+        }
+        const std::span<const Annotation> annotations{ COMPILED_FOR<RegisterSet> ? actions(annotation_id)
+                                                                                 : (*this)[annotation_id] };
+        for (const Annotation& annotation : annotations) {
+            assert(annotation.counter_id < counters.size());
+            if (!execute(annotation, counters[annotation.counter_id])) { return false; }
+        }
+        return true;
+    }
+
+    /// Execute a single @p annotation on @p counter. @return False if @p annotation is a failing test or a rejected
+    ///  operation.
+    template<class Register = CounterRegister>
+    static bool execute(const Annotation& annotation, Register& counter) {
+        const CounterValue value{ counter.value };
+        switch (annotation.opcode) {
+            case Annotation::Opcode::Increment: return counter.increment(annotation.operand);
+            case Annotation::Opcode::Decrement: return counter.decrement(annotation.operand);
+            case Annotation::Opcode::Reset: counter.reset(); return true;
+            case Annotation::Opcode::TestEqual: return value == annotation.operand;
+            case Annotation::Opcode::TestLess: return value < annotation.operand;
+            case Annotation::Opcode::TestGreaterEqual: return value >= annotation.operand;
+            case Annotation::Opcode::TestInRange: return value >= annotation.operand && value <= annotation.upper;
+        }
+        return true;
+    }
+
+private:
+    std::vector<size_t> offsets_{ 0 };
+    std::vector<Annotation> annotations_{};
+    std::vector<size_t> guard_offsets_{ 0 };
+    std::vector<Guard> guards_{};
+    std::vector<size_t> action_offsets_{ 0 };
+    std::vector<Annotation> actions_{};
+};
+
+} // namespace mata::nfa.
+
+#endif // THETA_HH
@@ -7,7 +7,9 @@
 #include <cstddef>
 #include <iostream>
 #include <limits>
+#include <memory_resource>
 
+#include "counter.hh"
 #include "mata/utils/ord-vector.hh"
 
 // Use this for undefined ID or index.
@@ -20,6 +22,12 @@ using Symbol = unsigned;
 using State = unsigned long;
 using StateSet = mata::utils::OrdVector<State>;
 
+// Note: Epsilon transitions are labelled with the symbol 0 (see main.cc).
+constexpr Symbol EPSILON{ 0 };
+
+// Convert an input character to a symbol. Input is treated as a sequence of bytes, so the result is in [0, 255].
+inline Symbol toSymbol(const char c) { return static_cast<unsigned char>(c); }
+
 // State with an annotation (@c State @c state and @c size_t @c annotation_id).
 // TODO: Move this to the annotation header file.
 struct AnnotationState {
@@ -40,16 +48,29 @@ struct AnnotationState {
     auto operator<=>(const State& other) const { return state <=> other; }
     bool operator==(const State other) const { return state == other; }
     auto operator<=>(const AnnotationState&) const = default;
-    bool operator==(const AnnotationState& other) const { return state == other; }
+    bool operator==(const AnnotationState&) const = default;
 
     operator State() const { return state; } // NOLINT(*-explicit-constructor)
 };
 
+// Number of targets stored inline in a target set; larger sets spill to the heap.
+constexpr size_t TARGET_SET_INLINE_CAPACITY{ 2 };
+
 // Set of states with annotation.
 // TODO: Move this to the annotation header file.
-class AnnotationStateSet : public mata::utils::OrdVector<AnnotationState> {
+// Target sets allocate from the memory resource of the owning Delta (see Delta(std::pmr::memory_resource*)).
+class AnnotationStateSet : public mata::utils::SmallOrdVector<AnnotationState, TARGET_SET_INLINE_CAPACITY,
+                                                              std::pmr::polymorphic_allocator<AnnotationState>> {
+private:
+    using super = mata::utils::SmallOrdVector<AnnotationState, TARGET_SET_INLINE_CAPACITY,
+                                              std::pmr::polymorphic_allocator<AnnotationState>>;
+
 public:
     AnnotationStateSet() = default;
+    explicit AnnotationStateSet(const allocator_type& allocator) : super(allocator) {}
+    AnnotationStateSet(const AnnotationStateSet& other, const allocator_type& allocator) : super(other, allocator) {}
+    AnnotationStateSet(AnnotationStateSet&& other, const allocator_type& allocator)
+        : super(std::move(other), allocator) {}
 
     AnnotationStateSet(State state) { // NOLINT(*-explicit-constructor)
         this->push_back(AnnotationState(state));
@@ -94,102 +115,6 @@ public:
     }
 };
 
-// TODO: Choose the best value for counters.
-using CounterValue = unsigned long;
-using CounterValueSet = mata::utils::OrdVector<CounterValue>;
-
-// Register for counters.
-// TODO: Create separate header file for counter types.
-struct CounterRegister {
-    size_t id; ///< Unique ID for the counter.
-    // Note: ID is the index in the counters vector.
-    // TODO: Is this a good idea? Think about better solutions.
-    CounterValue value; ///< Current counter value.
-    CounterValue initial_value; ///< Initial counter value.
-
-    CounterRegister() : id(UNDEFINED_ID), value(0), initial_value(0) {}
-    CounterRegister(size_t id, CounterValue value) : id(id), value(value), initial_value(value) {}
-
-    CounterRegister(const CounterRegister&) = default;
-    CounterRegister(CounterRegister&&) = default;
-    CounterRegister& operator=(const CounterRegister&) = default;
-    CounterRegister& operator=(CounterRegister&&) = default;
-
-    CounterRegister& operator=(CounterValue other) { value = other; return *this; }
-
-    auto operator<=>(const CounterValue& other) const { return value <=> other; }
-    auto operator<=>(const CounterRegister&) const = default;
-
-    operator CounterValue() const { return value; }
-
-    // Increment the counter by 1 (or specified amount).
-    void increment(CounterValue amount = 1) {
-        if (value > std::numeric_limits<CounterValue>::max() - amount) {
-            throw std::overflow_error("CounterRegister: Increment operation would result in overflow.");
-        }
-        value += amount;
-    }
-    // Decrement the counter by 1 (or specified amount).
-    void decrement(CounterValue amount = 1) {
-        if (amount > value) {
-            throw std::underflow_error("CounterRegister: Decrement operation would result in a negative value.");
-        }
-        value -= amount;
-    }
-    // Reset the counter to its initial value.
-    void reset() { value = initial_value; }
-    // Note: Custom debug output. This should be removed later.
-    void print() const {
-        std::cout << "ID: " << id << ", Value: " << value << ", Initial: " << initial_value << "\n";
-    }
-};
-
-// Set of counter registers.
-// TODO: Create separate header file for counter types.
-class CounterRegisterSet {
-private:
-    std::vector<CounterRegister> counters; ///< Stores counters.
-
-public:
-    // TODO: Add the necessary constructors later.
-    CounterRegisterSet() = default;
-
-    void addCounter(CounterValue value) {
-        counters.emplace_back(counters.size(), value);
-    }
-    // TODO: Change this to operator.
-    CounterRegister& getCounter(size_t id) {
-        if (id >= counters.size()) {
-            throw std::runtime_error("CounterRegisterSet: Counter with this ID does not exist.");
-        }
-        return counters[id];
-    }
-    const CounterRegister& getCounter(size_t id) const {
-        if (id >= counters.size()) {
-            throw std::runtime_error("CounterRegisterSet: Counter with this ID does not exist.");
-        }
-        return counters[id];
-    }
-    // This implementation of getCounter is probably better.
-    CounterRegister& operator[](size_t id) {
-        return counters[id];
-    }
-    const CounterRegister& operator[](size_t id) const {
-        return counters[id];
-    }
-    size_t size() {
-        return counters.size();
-    }
-    // Note: Custom debug output. This should be removed later.
-    void print() const {
-        for (const auto& counter : counters) {
-            counter.print();
-        }
-    }
-    // TODO: Add counter removal later.
-    // TODO: Add iterators later.
-};
-
 // Added for better readability.
 using Target = AnnotationState;
 using TargetSet = AnnotationStateSet;
@@ -0,0 +1,124 @@
+#ifndef VALUATION_HH
+#define VALUATION_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "counter.hh"
+
+namespace mata::nfa {
+
+/**
+ * Register-like view of a counter value stored in a packed valuation.
+ *
+ * Only the value lives in the valuation; the ID, the initial value and the arithmetic policy are taken from the
+ *  register @c layout of the automaton, which is kept once for all valuations. Can be passed to @c Theta::execute.
+ */
+template<class Register = CounterRegister>
+struct PackedRegister {
+    using ValueType = typename Register::ValueType;
+
+    ValueType& value;
+    const Register& layout;
+
+    bool increment(const CounterValue amount = 1) { return layout.arithmetic.increment(value, amount); }
+    bool decrement(const CounterValue amount = 1) { return layout.arithmetic.decrement(value, amount); }
+    void reset() { value = layout.initial_value; }
+};
+
+/// Hash of a packed valuation: a multiply-xorshift mix of its values.
+template<class Value>
+uint64_t hashValuation(const std::span<const Value> values) {
+    uint64_t hash{ 0x9e3779b97f4a7c15ULL ^ values.size() };
+    for (const Value value : values) {
+        hash = (hash ^ static_cast<uint64_t>(value)) * 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 31;
+    }
+    return hash;
+}
+
+/**
+ * Table of interned counter valuations.
+ *
+ * A valuation is a packed array of counter values, one per counter. All valuations of the table are stored back to
+ *  back in one contiguous array and are referred to by their @c ValuationId. Interning a valuation equal to a stored
+ *  one returns the ID of the stored one, so equal valuations are shared and compared in O(1) by their IDs.
+ *
+ * Lookup uses an open-addressing hash table of IDs with linear probing; the hashes of the valuations are cached to
+ *  skip most comparisons of values and to grow the table without rehashing.
+ */
+template<class Value = CounterValue>
+class BasicValuationTable {
+public:
+    using ValuationId = uint32_t;
+
+    explicit BasicValuationTable(const size_t num_of_counters = 0) : num_of_counters_{ num_of_counters } {}
+
+    size_t numCounters() const { return num_of_counters_; }
+    /// Number of interned valuations.
+    size_t size() const { return hashes_.size(); }
+    bool empty() const { return hashes_.empty(); }
+
+    /// Values of the valuation @p id.
+    std::span<const Value> operator[](const ValuationId id) const {
+        assert(id < size());
+        return { values_.data() + id * num_of_counters_, num_of_counters_ };
+    }
+
+    /// ID of the valuation equal to @p valuation, which is added if there is none yet.
+    ValuationId intern(const std::span<const Value> valuation) {
+        assert(valuation.size() == num_of_counters_);
+        if (2 * (size() + 1) > slots_.size()) { grow(); }
+
+        const uint64_t hash{ hashValuation(valuation) };
+        const size_t mask{ slots_.size() - 1 };
+        for (size_t slot{ hash & mask };; slot = (slot + 1) & mask) {
+            const ValuationId id{ slots_[slot] };
+            if (id == EMPTY_SLOT) {
+                slots_[slot] = static_cast<ValuationId>(size());
+                hashes_.push_back(hash);
+                values_.insert(values_.end(), valuation.begin(), valuation.end());
+                return slots_[slot];
+            }
+            if (hashes_[id] == hash && std::equal(valuation.begin(), valuation.end(), (*this)[id].begin())) {
+                return id;
+            }
+        }
+    }
+
+    /// Remove all valuations, keeping the allocated memory.
+    void clear() {
+        values_.clear();
+        hashes_.clear();
+        std::fill(slots_.begin(), slots_.end(), EMPTY_SLOT);
+    }
+
+private:
+    static constexpr ValuationId EMPTY_SLOT{ std::numeric_limits<ValuationId>::max() };
+
+    void grow() {
+        slots_.assign(std::max<size_t>(16, 2 * slots_.size()), EMPTY_SLOT);
+        const size_t mask{ slots_.size() - 1 };
+        for (ValuationId id{ 0 }; id < size(); ++id) {
+            size_t slot{ hashes_[id] & mask };
+            while (slots_[slot] != EMPTY_SLOT) { slot = (slot + 1) & mask; }
+            slots_[slot] = id;
+        }
+    }
+
+    size_t num_of_counters_;
+    std::vector<Value> values_{}; ///< Values of valuation @c i at [i * num_of_counters_, (i + 1) * num_of_counters_).
+    std::vector<uint64_t> hashes_{}; ///< Hash of each valuation.
+    std::vector<ValuationId> slots_{}; ///< Open-addressing hash table of valuation IDs (power-of-two size).
+};
+
+using ValuationTable = BasicValuationTable<>;
+using ValuationId = ValuationTable::ValuationId;
+
+} // namespace mata::nfa.
+
+#endif // VALUATION_HH
@@ -0,0 +1,44 @@
+/**
+    mapped-file.hh
+	Read-only memory mapping of a whole file.
+*/
+
+#ifndef MATA_MAPPED_FILE_HH_
+#define MATA_MAPPED_FILE_HH_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace mata::utils {
+
+/**
+ * File mapped read-only and shared into memory, unmapped on destruction.
+ *
+ * The pages are loaded on first access, so mapping is cheap regardless of the size of the file, and the pages are
+ *  shared with other processes mapping the same file.
+ */
+class MappedFile {
+public:
+    /// @throws std::runtime_error If the file cannot be opened or mapped.
+    explicit MappedFile(const std::string& path);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    const std::byte* data() const { return static_cast<const std::byte*>(address_); }
+    size_t size() const { return size_; }
+    /// Contents of the file as text.
+    std::string_view text() const { return { static_cast<const char*>(address_), size_ }; }
+
+    /// Advise the kernel that the file will be read sequentially (more read-ahead).
+    void adviseSequential() const;
+
+private:
+    void* address_{ nullptr };
+    size_t size_{ 0 };
+};
+
+} // namespace mata::utils.
+
+#endif // MATA_MAPPED_FILE_HH_
@@ -0,0 +1,53 @@
+/**
+    memory-usage.hh
+	Accounting of the heap memory owned by containers.
+*/
+
+#ifndef MATA_MEMORY_USAGE_HH_
+#define MATA_MEMORY_USAGE_HH_
+
+#include <cstddef>
+#include <ostream>
+
+namespace mata::utils {
+
+/**
+ * Heap memory owned by a data structure, not counting the structure itself (its @c sizeof, which its owner counts).
+ *
+ * Bytes are counted as requested from the allocator, without the bookkeeping of the allocator or memory resource.
+ */
+struct MemoryUsage {
+    size_t used{ 0 }; ///< Bytes holding elements.
+    size_t slack{ 0 }; ///< Bytes allocated for elements not added yet (capacity beyond the size).
+
+    size_t total() const { return used + slack; }
+
+    MemoryUsage& operator+=(const MemoryUsage& other) {
+        used += other.used;
+        slack += other.slack;
+        return *this;
+    }
+    friend MemoryUsage operator+(MemoryUsage lhs, const MemoryUsage& rhs) { return lhs += rhs; }
+    bool operator==(const MemoryUsage&) const = default;
+
+    friend std::ostream& operator<<(std::ostream& output, const MemoryUsage& usage) {
+        return output << usage.total() << " B (" << usage.slack << " B slack)";
+    }
+};
+
+/**
+ * Heap memory of the buffer of @p vector (a @c std::vector or a @c SmallVector, whose inline elements take no heap
+ *  memory). Heap memory owned by the elements is not included.
+ */
+template<class Vector>
+MemoryUsage vector_memory_usage(const Vector& vector) {
+    using T = typename Vector::value_type;
+    if constexpr (requires { vector.is_on_heap(); }) {
+        if (!vector.is_on_heap()) { return {}; }
+    }
+    return { vector.size() * sizeof(T), (vector.capacity() - vector.size()) * sizeof(T) };
+}
+
+} // namespace mata::utils.
+
+#endif // MATA_MEMORY_USAGE_HH_
@@ -1,7 +1,7 @@
 // Based on
 /**
     ord-vector.hh
-	Implementation of a set (ordered vector) using std::vector.
+	Implementation of a set (ordered vector) using std::vector (or another vector-like container).
     @author Mata Group
     https://github.com/VeriFIT/mata/blob/devel/include/mata/utils/ord-vector.hh
 */
@@ -14,6 +14,10 @@
 #include <cassert>
 
 #include "utils.hh"
+#include "memory-usage.hh"
+#include "simd-set-ops.hh"
+#include "search.hh"
+#include "small-vector.hh"
 
 namespace {
 /**
@@ -40,22 +44,22 @@ std::string to_str(const T& n) {
 
 namespace mata::utils {
 
-template <class Key> class OrdVector;
+template <class Key, class Vector = std::vector<Key>> class OrdVector;
 
-template <class T>
-bool are_disjoint(const utils::OrdVector<T>& lhs, const utils::OrdVector<T>& rhs) {
-    auto itLhs = lhs.begin();
-    auto itRhs = rhs.begin();
-    while (itLhs != lhs.end() && itRhs != rhs.end()) {
-        if (*itLhs == *itRhs) { return false; }
-        else if (*itLhs < *itRhs) { ++itLhs; }
-        else {++itRhs; }
-    }
-    return true;
+/**
+ * Ordered vector storing up to @p N elements inline, for sets which are almost always tiny.
+ */
+template <class Key, size_t N, class Allocator = std::allocator<Key>>
+using SmallOrdVector = OrdVector<Key, SmallVector<Key, N, Allocator>>;
+
+template <class T, class Vector>
+bool are_disjoint(const utils::OrdVector<T, Vector>& lhs, const utils::OrdVector<T, Vector>& rhs) {
+    return lhs.is_intersection_empty_with(rhs);
 }
 
-template <class Key>
-bool is_sorted(const std::vector<Key>& vec) {
+template <class Vector>
+bool is_sorted(const Vector& vec) {
+    if (vec.empty()) { return true; }
     for (auto itVec = vec.cbegin() + 1; itVec < vec.cend(); ++itVec) {
         if (!(*(itVec - 1) < *itVec)) {
             // In case there is an unordered pair (or there is one element twice).
@@ -73,12 +77,15 @@ bool is_sorted(const std::vector<Key>& vec) {
  *
  * @tparam  Key  Key type: type of the elements contained in the container.
  *               Each elements in a set is also its key.
+ * @tparam  Vector  Underlying vector-like container of @p Key (@c std::vector or @c SmallVector).
  */
-template<class Key> class OrdVector {
+template<class Key, class Vector> class OrdVector {
 private:  // Private data types
+    template<class, class> friend class OrdVector;
 
 public:   // Public data types
-    using VectorType = std::vector<Key>;
+    using VectorType = Vector;
+    using allocator_type = typename VectorType::allocator_type;
     using value_type = Key;
     using size_type = size_t;
     using iterator = typename VectorType::iterator ;
@@ -91,17 +98,25 @@ private:  // Private data members
 
 private:  // Private methods
     bool is_sorted() const { return mata::utils::is_sorted(vec_); }
+    /// View an element of another ordered vector as a @c Key, so that it is compared by the ordering of @c Key.
+    static const Key& as_key(const Key& key) { return key; }
+    template<class OtherKey> static Key as_key(const OtherKey& key) { return Key(key); }
 
 public:
     OrdVector() : vec_() {}
     explicit OrdVector(const VectorType& vec) : vec_(vec) { utils::sort_and_rmdupl(vec_); }
     explicit OrdVector(const std::set<Key>& set): vec_{ set.begin(), set.end() } { utils::sort_and_rmdupl(vec_); }
-    template <class T>
+    template <class T> requires (!std::is_convertible_v<const T&, allocator_type>)
     explicit OrdVector(const T & set) : vec_(set.begin(), set.end()) { utils::sort_and_rmdupl(vec_); }
     OrdVector(std::initializer_list<Key> list) : vec_(list) { utils::sort_and_rmdupl(vec_); }
     OrdVector(const OrdVector& rhs) = default;
     OrdVector(OrdVector&& other) noexcept : vec_{ std::move(other.vec_) } {}
     explicit OrdVector(const Key& key) : vec_(1, key) { assert(is_sorted()); }
+    // Allocator-extended constructors, so that OrdVectors nested in containers with a scoped allocator (e.g.,
+    //  std::pmr::polymorphic_allocator) allocate from the same memory resource.
+    explicit OrdVector(const allocator_type& allocator) : vec_(allocator) {}
+    OrdVector(const OrdVector& rhs, const allocator_type& allocator) : vec_(rhs.vec_, allocator) {}
+    OrdVector(OrdVector&& rhs, const allocator_type& allocator) : vec_(std::move(rhs.vec_), allocator) {}
     template <class InputIterator>
     explicit OrdVector(InputIterator first, InputIterator last) : vec_(first, last) { utils::sort_and_rmdupl(vec_); }
 
@@ -115,7 +130,7 @@ public:
         return *this;
     }
 
-    virtual ~OrdVector() = default;
+    ~OrdVector() = default;
 
     /**
      * Create OrdVector with reserved @p capacity.
@@ -152,19 +167,24 @@ public:
     // but useful in NFA where temporarily breaking the sortedness invariant allows for a faster algorithm (e.g. revert)
     reference push_back(Key&& t) { return emplace_back(std::move(t)); }
 
-    virtual inline void reserve(size_t size) { vec_.reserve(size); }
-    virtual inline void resize(size_t size) { vec_.resize(size); }
+    allocator_type get_allocator() const { return vec_.get_allocator(); }
+
+    inline void reserve(size_t size) { vec_.reserve(size); }
+    inline void resize(size_t size) { vec_.resize(size); }
+    /// Release the capacity beyond the size (e.g., reserved by @c reserve_on_insert).
+    inline void shrink_to_fit() { vec_.shrink_to_fit(); }
+    /// Heap memory of the buffer; heap memory owned by the elements is not included.
+    MemoryUsage memory_usage() const { return vector_memory_usage(vec_); }
 
-    virtual inline iterator erase(const_iterator pos) { return vec_.erase(pos); }
-    virtual inline iterator erase(const_iterator first, const_iterator last) { return vec_.erase(first, last); }
+    inline iterator erase(const_iterator pos) { return vec_.erase(pos); }
+    inline iterator erase(const_iterator first, const_iterator last) { return vec_.erase(first, last); }
 
-    virtual void insert(const Key& x) {
+    void insert(const Key& x) {
         assert(is_sorted());
 
         reserve_on_insert(vec_);
 
-        // Tomas Fiedor: article about better binary search here https://mhdm.dev/posts/sb_lower_bound/.
-        auto pos  = std::lower_bound(vec_.begin(), vec_.end(), x);
+        auto pos  = branchless_lower_bound(vec_.begin(), vec_.end(), x);
         if (pos == vec_.end() || *pos != x)
             vec_.insert(pos,x);
 
@@ -205,38 +225,66 @@ public:
         assert(is_sorted());
     }
 
-    virtual void insert(const OrdVector& vec) {
-        static OrdVector tmp{};
+    void insert(const OrdVector& vec) { insert<Key, Vector>(vec); }
+
+    /**
+     * @brief Insert all elements of the ordered vector @p vec (set union in place).
+     *
+     * Linear-time merge without any temporary vector: the number of new elements is counted first, the vector is
+     *  grown once (amortised by the geometric growth of the underlying vector) and both vectors are then merged
+     *  from the back. Elements of @p vec must be convertible to @c Key; they are compared as converted, so that the
+     *  union is ordered and deduplicated by the same ordering as @c insert(const Key&).
+     */
+    template<class OtherKey, class OtherVector>
+    void insert(const OrdVector<OtherKey, OtherVector>& vec) {
         assert(is_sorted());
         assert(vec.is_sorted());
-        tmp.clear();
 
-        set_union(*this,vec,tmp);
+        stats::add(&stats::Stats::unions);
+        stats::add(&stats::Stats::union_elements, size() + vec.size());
+        if (vec.empty()) { return; }
+        if (vec_.empty() || vec_.back() < as_key(vec.front())) {
+            vec_.insert(vec_.end(), vec.begin(), vec.end());
+            return;
+        }
+
+        // Count the elements of vec which are not present yet.
+        size_t num_of_new{ 0 };
+        auto this_it{ vec_.cbegin() };
+        for (const auto& other_key : vec) {
+            const auto& key{ as_key(other_key) };
+            while (this_it != vec_.cend() && *this_it < key) { ++this_it; }
+            if (this_it == vec_.cend() || *this_it != key) { ++num_of_new; }
+        }
+        if (num_of_new == 0) { return; }
+
+        // Merge from the back into the grown vector. Once all new elements are placed, the rest is already in place.
+        const size_t old_size{ vec_.size() };
+        vec_.resize(old_size + num_of_new);
+        size_t this_index{ old_size };
+        size_t write_index{ vec_.size() };
+        for (auto vec_it{ vec.end() }; vec_it != vec.begin() && write_index != this_index;) {
+            const auto& key{ as_key(*std::prev(vec_it)) };
+            if (this_index != 0 && key < vec_[this_index - 1]) {
+                vec_[--write_index] = std::move(vec_[--this_index]);
+            } else {
+                if (this_index != 0 && vec_[this_index - 1] == key) {
+                    vec_[--write_index] = std::move(vec_[--this_index]);
+                } else {
+                    vec_[--write_index] = key;
+                }
+                --vec_it;
+            }
+        }
 
-        vec_ = tmp.vec_;
-        /*
-         * Swap, commented below (test do pass) may be better in some cases, such as uniting many vectors into one.
-         * But it defeats the idea of having tmp vector shared between all the unions and allocated only once.
-         * It would be good to try it with removing epsilon transitions or determinization.
-         */
-        //std::swap(tmp.vec_,vec_);
         assert(is_sorted());
     }
 
     inline void clear() { vec_.clear(); }
 
-    virtual inline size_t size() const { return vec_.size(); }
+    inline size_t size() const { return vec_.size(); }
 
-    inline size_t count(const Key& key) const {
-        assert(is_sorted());
-        for (auto v : this->vec_) {
-            if (v == key)
-                return 1;
-            else if (v > key)
-                return 0;
-        }
-        return 0;
-    }
+    inline size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
 
     /**
      * Compute set difference as @c this minus @p rhs.
@@ -247,28 +295,28 @@ public:
 
     OrdVector intersection(const OrdVector& rhs) const { return intersection(*this, rhs); }
 
-    virtual const_iterator find(const Key& key) const {
+    const_iterator find(const Key& key) const {
         assert(is_sorted());
 
-        auto it = std::lower_bound(vec_.begin(), vec_.end(),key);
+        auto it = branchless_lower_bound(vec_.begin(), vec_.end(), key);
         if (it == vec_.end() || *it != key)
             return vec_.end();
         else
             return it;
     }
 
-    virtual iterator find(const Key& key) {
+    iterator find(const Key& key) {
         assert(is_sorted());
 
-        auto it = std::lower_bound(vec_.begin(), vec_.end(),key);
+        auto it = branchless_lower_bound(vec_.begin(), vec_.end(), key);
         if (it == vec_.end() || *it != key)
             return vec_.end();
         else
             return it;
     }
 
-    virtual const Key& front() const { return vec_[0]; }
-    virtual Key& front() { return vec_[0]; }
+    const Key& front() const { return vec_[0]; }
+    Key& front() { return vec_[0]; }
 
     /**
      * Check whether @p key exists in the ordered vector.
@@ -282,7 +330,7 @@ public:
      */
     inline size_t erase(const Key& k) {
         assert(is_sorted());
-        auto found_value_it = std::lower_bound(vec_.begin(), vec_.end(), k);
+        auto found_value_it = branchless_lower_bound(vec_.begin(), vec_.end(), k);
         if (found_value_it != vec_.end()) {
             if (*found_value_it == k) {
                 vec_.erase(found_value_it);
@@ -294,7 +342,7 @@ public:
         return 0;
     }
 
-    virtual inline bool empty() const { return vec_.empty(); }
+    inline bool empty() const { return vec_.empty(); }
 
     // Indexes which ar staying are shifted left to take place of those that are not staying.
     template<typename Fun>
@@ -308,25 +356,25 @@ public:
         utils::filter(vec_, is_staying);
     }
 
-    virtual inline const_reference back() const { return vec_.back(); }
+    inline const_reference back() const { return vec_.back(); }
 
     /**
      * @brief Get reference to the last element in the vector.
      *
      * Modifying the underlying value in the reference could break sortedness.
      */
-    virtual inline reference back() { return vec_.back(); }
+    inline reference back() { return vec_.back(); }
 
-    virtual inline void pop_back() { return vec_.pop_back(); }
+    inline void pop_back() { return vec_.pop_back(); }
 
-    virtual inline const_iterator begin() const { return vec_.begin(); }
-    virtual inline const_iterator end() const { return vec_.end(); }
+    inline const_iterator begin() const { return vec_.begin(); }
+    inline const_iterator end() const { return vec_.end(); }
 
-    virtual inline iterator begin() { return vec_.begin(); }
-    virtual inline iterator end() { return vec_.end(); }
+    inline iterator begin() { return vec_.begin(); }
+    inline iterator end() { return vec_.end(); }
 
-	virtual inline const_iterator cbegin() const { return begin(); }
-	virtual inline const_iterator cend() const { return end(); }
+	inline const_iterator cbegin() const { return begin(); }
+	inline const_iterator cend() const { return end(); }
 
 	/**
 	 * @brief  Overloaded << operator
@@ -362,9 +410,12 @@ public:
         return std::lexicographical_compare(vec_.begin(), vec_.end(), rhs.vec_.begin(), rhs.vec_.end());
     }
 
-    const std::vector<Key>& to_vector() const { return vec_; }
+    const VectorType& to_vector() const { return vec_; }
 
     bool is_subset_of(const OrdVector& bigger) const {
+        if constexpr (simd::is_supported_key<Key>) {
+            return simd::is_subset_of(vec_.data(), vec_.size(), bigger.vec_.data(), bigger.vec_.size());
+        }
         return std::includes(bigger.cbegin(), bigger.cend(), this->cbegin(), this->cend());
     }
 
@@ -372,6 +423,10 @@ public:
         assert(is_sorted());
         assert(rhs.is_sorted());
 
+        if constexpr (simd::is_supported_key<Key>) {
+            return simd::is_intersection_empty(vec_.data(), vec_.size(), rhs.vec_.data(), rhs.vec_.size());
+        }
+
         const_iterator itLhs = begin();
         const_iterator itRhs = rhs.begin();
 
@@ -402,6 +457,13 @@ public:
         assert(rhs.is_sorted());
 
         OrdVector result{};
+        if constexpr (simd::is_supported_key<Key>) {
+            result.vec_.resize(lhs.size());
+            result.vec_.resize(simd::difference(lhs.vec_.data(), lhs.size(), rhs.vec_.data(), rhs.size(),
+                                                result.vec_.data()));
+            assert(result.is_sorted());
+            return result;
+        }
         auto lhs_it{ lhs.begin() };
         auto rhs_it{ rhs.begin() };
 
@@ -427,11 +489,14 @@ public:
     static void set_union(const OrdVector& lhs, const OrdVector& rhs, OrdVector& result) {
         assert(lhs.is_sorted());
         assert(rhs.is_sorted());
+        stats::add(&stats::Stats::unions);
+        stats::add(&stats::Stats::union_elements, lhs.size() + rhs.size());
 
         if (lhs.empty()) { result = rhs; return; }
         if (rhs.empty()) { result = lhs; return; }
 
         result.reserve(lhs.size()+rhs.size());
+        // The union has no vectorized kernel in simd-set-ops.hh: a deduplicating merge does not map well onto shuffles.
         std::set_union(lhs.vec_.begin(),lhs.vec_.end(),rhs.vec_.begin(),rhs.vec_.end(),std::back_inserter(result.vec_));
 
         //TODO: measure, if there is not benefit to this custom version, remove
@@ -474,6 +539,13 @@ public:
         assert(rhs.is_sorted());
 
         OrdVector result{};
+        if constexpr (simd::is_supported_key<Key>) {
+            result.vec_.resize(std::min(lhs.size(), rhs.size()));
+            result.vec_.resize(simd::intersection(lhs.vec_.data(), lhs.size(), rhs.vec_.data(), rhs.size(),
+                                                  result.vec_.data()));
+            assert(result.is_sorted());
+            return result;
+        }
 
         auto lhs_it = lhs.begin();
         auto rhs_it = rhs.vec_.begin();
@@ -498,10 +570,10 @@ public:
 } // Namespace mata::utils.
 
 namespace std {
-    template <class Key>
-    struct hash<mata::utils::OrdVector<Key>> {
-        std::size_t operator()(const mata::utils::OrdVector<Key>& vec) const {
-            return std::hash<std::vector<Key>>{}(vec.to_vector());
+    template <class Key, class Vector>
+    struct hash<mata::utils::OrdVector<Key, Vector>> {
+        std::size_t operator()(const mata::utils::OrdVector<Key, Vector>& vec) const {
+            return mata::utils::hash_range(vec.begin(), vec.end());
         }
     };
 }
@@ -0,0 +1,32 @@
+/**
+    search.hh
+	Search in sorted sequences.
+*/
+
+#ifndef MATA_SEARCH_HH_
+#define MATA_SEARCH_HH_
+
+namespace mata::utils {
+
+/**
+ * @brief Branchless lower bound.
+ *
+ * Same result as @c std::lower_bound, but the loop body has no data-dependent branch (the comparison compiles to a
+ *  conditional move), so there are no branch mispredictions. See https://mhdm.dev/posts/sb_lower_bound/.
+ */
+template<class RandomIt, class T>
+RandomIt branchless_lower_bound(RandomIt first, const RandomIt last, const T& value) {
+    auto length{ last - first };
+    if (length == 0) { return first; }
+    // Invariant: the lower bound is in [first, first + length].
+    while (length > 1) {
+        const auto half{ length / 2 };
+        first = (first[half] < value) ? first + half : first;
+        length -= half;
+    }
+    return first + (*first < value);
+}
+
+} // namespace mata::utils.
+
+#endif // MATA_SEARCH_HH_
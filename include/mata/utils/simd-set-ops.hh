@@ -0,0 +1,47 @@
+/**
+    simd-set-ops.hh
+	Vectorized set operations over sorted arrays of unique 64-bit numbers.
+*/
+
+#ifndef MATA_SIMD_SET_OPS_HH_
+#define MATA_SIMD_SET_OPS_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace mata::utils::simd {
+
+using Element = std::uint64_t;
+
+/// Keys for which @c OrdVector uses the kernels below.
+template<class Key>
+inline constexpr bool is_supported_key = std::is_same_v<Key, Element>;
+
+enum class InstructionSet { Scalar, Sse41, Avx2 };
+
+/**
+ * @brief Select the instruction set used by the kernels.
+ *
+ * The best instruction set supported by the CPU is selected automatically at the first use, this is meant for
+ *  benchmarks and debugging. Not thread-safe.
+ * @return False if the CPU does not support @p instruction_set (the selection is not changed then).
+ */
+bool set_instruction_set(InstructionSet instruction_set);
+InstructionSet get_instruction_set();
+const char* to_string(InstructionSet instruction_set);
+
+// All arrays are sorted and without duplicates. The result array must have space for the largest possible result
+//  (the size of @p lhs for intersection and difference) and must not overlap the inputs.
+
+/// Compute @p lhs intersected with @p rhs into @p result and return the size of the result.
+size_t intersection(const Element* lhs, size_t lhs_size, const Element* rhs, size_t rhs_size, Element* result);
+/// Compute @p lhs minus @p rhs into @p result and return the size of the result.
+size_t difference(const Element* lhs, size_t lhs_size, const Element* rhs, size_t rhs_size, Element* result);
+bool is_intersection_empty(const Element* lhs, size_t lhs_size, const Element* rhs, size_t rhs_size);
+/// Check whether @p lhs is a subset of @p rhs.
+bool is_subset_of(const Element* lhs, size_t lhs_size, const Element* rhs, size_t rhs_size);
+
+} // namespace mata::utils::simd.
+
+#endif // MATA_SIMD_SET_OPS_HH_
@@ -0,0 +1,315 @@
+/**
+    small-vector.hh
+	Vector with inline storage for a few elements.
+*/
+
+#ifndef MATA_SMALL_VECTOR_HH_
+#define MATA_SMALL_VECTOR_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace mata::utils {
+
+/**
+ * @brief Vector storing up to @p N elements inline, without any heap allocation.
+ *
+ * Elements are moved to a heap buffer obtained from @p Allocator once the vector grows beyond @p N elements (and
+ *  moved back by @c shrink_to_fit() when they fit again). The interface is the subset of @c std::vector used by
+ *  @c OrdVector; iterators are plain pointers.
+ *
+ * Elements are constructed through @c std::allocator_traits, so allocator-aware elements of a vector with
+ *  a scoped allocator (such as @c std::pmr::polymorphic_allocator) receive the allocator of the vector.
+ *
+ * @tparam T Element type.
+ * @tparam N Number of elements stored inline.
+ * @tparam Allocator Allocator used for the heap buffer.
+ */
+template<class T, size_t N, class Allocator = std::allocator<T>>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs space for at least one inline element");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+private:
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    T* data_;
+    uint32_t size_{ 0 };
+    uint32_t capacity_{ N };
+    [[no_unique_address]] Allocator allocator_;
+    alignas(T) std::byte inline_storage_[N * sizeof(T)];
+
+    T* inline_data() { return std::launder(reinterpret_cast<T*>(inline_storage_)); }
+    const T* inline_data() const { return std::launder(reinterpret_cast<const T*>(inline_storage_)); }
+    bool is_inline() const { return data_ == inline_data(); }
+
+    void destroy(T* first, T* last) {
+        for (; first != last; ++first) { AllocatorTraits::destroy(allocator_, first); }
+    }
+
+    void release_heap() {
+        if (!is_inline()) { AllocatorTraits::deallocate(allocator_, data_, capacity_); }
+        data_ = inline_data();
+        capacity_ = N;
+    }
+
+    /// Move all elements to a new buffer (inline if @p new_capacity is @c N) of @p new_capacity elements.
+    void reallocate(const size_t new_capacity) {
+        assert(new_capacity >= size_ && new_capacity <= std::numeric_limits<uint32_t>::max());
+        T* new_data{ new_capacity == N ? inline_data() : AllocatorTraits::allocate(allocator_, new_capacity) };
+        if (new_data == data_) { return; }
+        for (uint32_t i{ 0 }; i < size_; ++i) {
+            AllocatorTraits::construct(allocator_, new_data + i, std::move(data_[i]));
+        }
+        destroy(data_, data_ + size_);
+        if (!is_inline()) { AllocatorTraits::deallocate(allocator_, data_, capacity_); }
+        data_ = new_data;
+        capacity_ = static_cast<uint32_t>(new_capacity);
+    }
+
+    size_t grown_capacity(const size_t needed) const { return std::max<size_t>(2 * size_t{ capacity_ }, needed); }
+
+    /// Take over the elements of @p other, which has an equal allocator. @pre This vector is empty and inline.
+    void steal(SmallVector& other) {
+        if (other.is_inline()) {
+            for (uint32_t i{ 0 }; i < other.size_; ++i) {
+                AllocatorTraits::construct(allocator_, data_ + i, std::move(other.data_[i]));
+            }
+            size_ = other.size_;
+            other.clear();
+        } else {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.size_ = 0;
+            other.capacity_ = N;
+        }
+    }
+
+public:
+    SmallVector() noexcept(noexcept(Allocator())) : SmallVector(Allocator()) {}
+    explicit SmallVector(const Allocator& allocator) noexcept : data_{ inline_data() }, allocator_{ allocator } {}
+    explicit SmallVector(const size_type count, const Allocator& allocator = Allocator()) : SmallVector(allocator) {
+        resize(count);
+    }
+    SmallVector(const size_type count, const T& value, const Allocator& allocator = Allocator())
+        : SmallVector(allocator) { resize(count, value); }
+    template<std::input_iterator InputIterator>
+    SmallVector(InputIterator first, InputIterator last, const Allocator& allocator = Allocator())
+        : SmallVector(allocator) { insert(end(), first, last); }
+    SmallVector(std::initializer_list<T> list, const Allocator& allocator = Allocator())
+        : SmallVector(list.begin(), list.end(), allocator) {}
+
+    SmallVector(const SmallVector& other)
+        : SmallVector(other, AllocatorTraits::select_on_container_copy_construction(other.allocator_)) {}
+    SmallVector(const SmallVector& other, const Allocator& allocator) : SmallVector(allocator) {
+        insert(end(), other.begin(), other.end());
+    }
+    SmallVector(SmallVector&& other) noexcept : SmallVector(other.allocator_) { steal(other); }
+    SmallVector(SmallVector&& other, const Allocator& allocator) : SmallVector(allocator) {
+        if (allocator_ == other.allocator_) {
+            steal(other);
+        } else {
+            insert(end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            other.clear();
+        }
+    }
+
+    ~SmallVector() {
+        clear();
+        release_heap();
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value) {
+                if (allocator_ != other.allocator_) { release_heap(); }
+                allocator_ = other.allocator_;
+            }
+            insert(end(), other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(AllocatorTraits::is_always_equal::value
+                                                         || AllocatorTraits::propagate_on_container_move_assignment::value) {
+        if (this == &other) { return *this; }
+        clear();
+        if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+            release_heap();
+            allocator_ = other.allocator_;
+            steal(other);
+        } else if (allocator_ == other.allocator_) {
+            release_heap();
+            steal(other);
+        } else {
+            insert(end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            other.clear();
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const { return allocator_; }
+
+    iterator begin() { return data_; }
+    const_iterator begin() const { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator end() const { return data_ + size_; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_type capacity() const { return capacity_; }
+    static constexpr size_type inline_capacity() { return N; }
+    /// Whether the elements are stored in a heap buffer.
+    bool is_on_heap() const { return !is_inline(); }
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+
+    reference operator[](const size_type index) { return data_[index]; }
+    const_reference operator[](const size_type index) const { return data_[index]; }
+    reference front() { return data_[0]; }
+    const_reference front() const { return data_[0]; }
+    reference back() { return data_[size_ - 1]; }
+    const_reference back() const { return data_[size_ - 1]; }
+
+    void reserve(const size_type new_capacity) {
+        if (new_capacity > capacity_) { reallocate(new_capacity); }
+    }
+
+    /// Release unused capacity, moving the elements back inline if they fit.
+    void shrink_to_fit() {
+        if (!is_inline() && size_ < capacity_) { reallocate(std::max<size_t>(size_, N)); }
+    }
+
+    void clear() {
+        destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    template<class... Args>
+    reference emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            // Construct the new element first, the arguments may refer to the elements being moved.
+            const size_t new_capacity{ grown_capacity(size_t{ size_ } + 1) };
+            T* new_data{ AllocatorTraits::allocate(allocator_, new_capacity) };
+            AllocatorTraits::construct(allocator_, new_data + size_, std::forward<Args>(args)...);
+            for (uint32_t i{ 0 }; i < size_; ++i) {
+                AllocatorTraits::construct(allocator_, new_data + i, std::move(data_[i]));
+            }
+            destroy(data_, data_ + size_);
+            if (!is_inline()) { AllocatorTraits::deallocate(allocator_, data_, capacity_); }
+            data_ = new_data;
+            capacity_ = static_cast<uint32_t>(new_capacity);
+        } else {
+            AllocatorTraits::construct(allocator_, data_ + size_, std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() { AllocatorTraits::destroy(allocator_, data_ + --size_); }
+
+    /// Resize to @p new_size elements. Growing beyond the capacity grows it geometrically, as @c emplace_back().
+    void resize(const size_type new_size) {
+        if (new_size < size_) {
+            destroy(data_ + new_size, data_ + size_);
+        } else {
+            if (new_size > capacity_) { reallocate(grown_capacity(new_size)); }
+            for (T* it{ data_ + size_ }; it != data_ + new_size; ++it) { AllocatorTraits::construct(allocator_, it); }
+        }
+        size_ = static_cast<uint32_t>(new_size);
+    }
+
+    void resize(const size_type new_size, const T& value) {
+        if (new_size < size_) {
+            destroy(data_ + new_size, data_ + size_);
+        } else {
+            if (new_size > capacity_) { reallocate(grown_capacity(new_size)); }
+            for (T* it{ data_ + size_ }; it != data_ + new_size; ++it) {
+                AllocatorTraits::construct(allocator_, it, value);
+            }
+        }
+        size_ = static_cast<uint32_t>(new_size);
+    }
+
+    template<class... Args>
+    iterator emplace(const_iterator position, Args&&... args) {
+        const auto index{ static_cast<size_t>(position - data_) };
+        if (index == size_) {
+            emplace_back(std::forward<Args>(args)...);
+            return data_ + index;
+        }
+        // The new element is built aside (the arguments may refer to elements being shifted), with the allocator of
+        //  the vector so that moving it into place does not have to copy.
+        alignas(T) std::byte value_storage[sizeof(T)];
+        T* const value{ reinterpret_cast<T*>(value_storage) };
+        AllocatorTraits::construct(allocator_, value, std::forward<Args>(args)...);
+        emplace_back(std::move(back()));
+        std::move_backward(data_ + index, data_ + size_ - 2, data_ + size_ - 1);
+        data_[index] = std::move(*value);
+        AllocatorTraits::destroy(allocator_, value);
+        return data_ + index;
+    }
+
+    iterator insert(const_iterator position, const T& value) { return emplace(position, value); }
+    iterator insert(const_iterator position, T&& value) { return emplace(position, std::move(value)); }
+
+    template<std::input_iterator InputIterator>
+    iterator insert(const_iterator position, InputIterator first, InputIterator last) {
+        const auto index{ static_cast<size_t>(position - data_) };
+        const size_t old_size{ size_ };
+        if constexpr (std::forward_iterator<InputIterator>) {
+            const auto count{ static_cast<size_t>(std::distance(first, last)) };
+            if (size_ + count > capacity_) { reallocate(grown_capacity(size_ + count)); }
+        }
+        for (; first != last; ++first) { emplace_back(*first); }
+        std::rotate(data_ + index, data_ + old_size, data_ + size_);
+        return data_ + index;
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        T* const first_mutable{ data_ + (first - data_) };
+        if (first != last) {
+            T* const new_end{ std::move(first_mutable + (last - first), end(), first_mutable) };
+            destroy(new_end, end());
+            size_ = static_cast<uint32_t>(new_end - data_);
+        }
+        return first_mutable;
+    }
+
+    iterator erase(const_iterator position) { return erase(position, position + 1); }
+
+    bool operator==(const SmallVector& other) const { return std::equal(begin(), end(), other.begin(), other.end()); }
+    bool operator<(const SmallVector& other) const {
+        return std::lexicographical_compare(begin(), end(), other.begin(), other.end());
+    }
+};
+
+} // namespace mata::utils.
+
+#endif // MATA_SMALL_VECTOR_HH_
@@ -83,6 +83,14 @@ concept Iterable = requires(T t) {
 
         void clear() { size_ = 0;  }
 
+        /// Heap memory of the dense and sparse arrays, both as large as the domain.
+        MemoryUsage memory_usage() const { return vector_memory_usage(dense) + vector_memory_usage(sparse); }
+        /// Release the capacity of the arrays beyond the domain.
+        void shrink_to_fit() {
+            dense.shrink_to_fit();
+            sparse.shrink_to_fit();
+        }
+
         // TODO: maybe we could reserve space more efficiently, by something as doubling?
         //  But we should not create havoc with domain_size, which is used outside, namely for determining the states of an automaton.
         void reserve(size_t u) {
@@ -102,6 +110,7 @@ concept Iterable = requires(T t) {
 
         void insert(const Number val) {
             assert(consistent());
+            stats::add(&stats::Stats::sparse_set_inserts);
 
             if (!contains(val)) {
                 if (static_cast<size_t>(val) >= domain_size_) {
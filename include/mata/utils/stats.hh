@@ -0,0 +1,84 @@
+/**
+    stats.hh
+	Counters of the operations on the hot paths, compiled in only with MATA_STATS defined (make STATS=1).
+*/
+
+#ifndef MATA_STATS_HH_
+#define MATA_STATS_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+
+namespace mata::utils::stats {
+
+#ifdef MATA_STATS
+inline constexpr bool ENABLED{ true };
+#else
+inline constexpr bool ENABLED{ false };
+#endif
+
+/// Numbers of operations since the last @c reset(), counted per thread.
+struct Stats {
+    /// Targets visited by the explicit simulations (including the successors computed by @c LazyDfa on cache misses).
+    ///  The bit-parallel simulation and cache hits of @c LazyDfa visit no targets and are not counted.
+    size_t transitions_examined{ 0 };
+    size_t symbol_searches{ 0 }; ///< Searches for the symbol post of a symbol in a state post.
+    size_t unions{ 0 }; ///< Unions of ordered vectors (@c set_union and inserting a vector).
+    size_t union_elements{ 0 }; ///< Sum of the sizes of the operands of the unions.
+    size_t sparse_set_inserts{ 0 }; ///< Calls of @c SparseSet::insert (including present elements).
+    size_t reallocations{ 0 }; ///< Reservations made by @c reserve_on_insert.
+    size_t simulations{ 0 }; ///< Runs of @c Nfa::simulate and @c Nfa::simulateWithCounters.
+    /// Largest number of active states (configurations with counters) after a step of any simulation.
+    size_t peak_active_states{ 0 };
+    /// Largest number of active states after a step of the last simulation, see @c start_simulation().
+    size_t last_peak_active_states{ 0 };
+
+    /// Print the counters, one per line.
+    void print(std::ostream& output) const {
+        output << "transitions examined: " << transitions_examined << "\n"
+               << "symbol searches: " << symbol_searches << "\n"
+               << "unions: " << unions << " (" << union_elements << " elements)\n"
+               << "SparseSet inserts: " << sparse_set_inserts << "\n"
+               << "reserve_on_insert reallocations: " << reallocations << "\n"
+               << "simulations: " << simulations << "\n"
+               << "peak active states: " << peak_active_states << " (last simulation: " << last_peak_active_states
+               << ")\n";
+    }
+};
+
+/// Counters of the calling thread. Always zero unless @c ENABLED.
+inline Stats& get() {
+    static thread_local Stats stats{};
+    return stats;
+}
+
+inline void reset() { get() = {}; }
+
+/// Add @p amount to @p counter. Compiled out unless @c ENABLED.
+inline void add(size_t Stats::* counter, const size_t amount = 1) {
+    if constexpr (ENABLED) { get().*counter += amount; }
+}
+
+/// Raise @p counter to @p value if it is larger. Compiled out unless @c ENABLED.
+inline void peak(size_t Stats::* counter, const size_t value) {
+    if constexpr (ENABLED) { get().*counter = std::max(get().*counter, value); }
+}
+
+/// Count a run of a simulation and start the peak of its active states. Compiled out unless @c ENABLED.
+inline void start_simulation() {
+    if constexpr (ENABLED) {
+        ++get().simulations;
+        get().last_peak_active_states = 0;
+    }
+}
+
+/// Record @p num_of_states active states after a step of the running simulation. Compiled out unless @c ENABLED.
+inline void active_states(const size_t num_of_states) {
+    peak(&Stats::peak_active_states, num_of_states);
+    peak(&Stats::last_peak_active_states, num_of_states);
+}
+
+} // namespace mata::utils::stats.
+
+#endif // MATA_STATS_HH_
@@ -21,6 +21,8 @@
 #include <vector>
 #include <cstdint>
 
+#include "stats.hh"
+
 /// macro for debug outputs
 #define PRINT_VERBOSE_LVL(lvl, title, x) {\
 	if (mata::LOG_VERBOSITY >= lvl) {\
@@ -230,13 +232,18 @@ struct TuplePrinter<Tuple, 1> {
 //  around 30% speedup for fragile revert,
 //  more than 50% for simple revert,
 // (when testing on a stupid test case)
+// Vectors with inline storage (SmallVector) are left to their own geometric growth: a large first reserve would spill
+//  them to the heap right away.
 template<class Vector>
 void inline reserve_on_insert(Vector & vec,size_t needed_capacity = 0,size_t extension = 32) {
+    if constexpr (requires { Vector::inline_capacity(); }) { return; }
     //return; //Try this to see the effect of calling this. It should not affect functionality.
     if (vec.capacity() < extension) //if the size is already large enough, leave it to the default doubling strategy. This if seems to make a barely noticeable difference :).
     {
-        if (vec.capacity() < std::max(vec.size() + 1, needed_capacity))
+        if (vec.capacity() < std::max(vec.size() + 1, needed_capacity)) {
             vec.reserve(vec.size() + extension);
+            stats::add(&stats::Stats::reallocations);
+        }
     }
 }
 
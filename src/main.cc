@@ -2,6 +2,8 @@
 
 #include "../include/mata/nfa/delta.hh"
 #include "../include/mata/nfa//nfa.hh"
+#include "../include/mata/nfa/lazy-dfa.hh"
+#include "../include/mata/utils/stats.hh"
 
 using namespace mata::nfa;
 using namespace mata::utils;
@@ -28,11 +30,13 @@ int main() {
     counters.addCounter(4);
     counters.print();
 
-    // TODO: Create Theta.
-
     // Create NFA.
     Nfa nfa(delta, initial, final, counters);
 
+    // Construction is done, pack the transitions for faster matching.
+    nfa.freeze();
+    std::cout << "Bit-parallel simulation: " << (nfa.isBitParallel() ? "yes" : "no") << "\n";
+
     // Test inputs for NFA.
     std::string testInputs[] = {"ab", "abc", "abccc", "a", "ac"};
 
@@ -46,6 +50,55 @@ int main() {
         }
     }
 
+    // Simulate the NFA using the lazily determinized automaton (run twice to reuse the cache).
+    LazyDfa lazy_dfa(nfa);
+    for (int run = 0; run < 2; ++run) {
+        for (const auto& input : testInputs) {
+            std::cout << "Lazy DFA input: \"" << input << "\" "
+                      << (lazy_dfa.simulate(input) ? "Accepted!" : "Rejected.") << "\n";
+        }
+    }
+    std::cout << "Lazy DFA cache: " << lazy_dfa.numMacroStates() << " macrostates, "
+              << lazy_dfa.getStats().hits << " hits, " << lazy_dfa.getStats().misses << " misses.\n";
+
+    // Create a counting automaton for a{3}b: counter 0 counts the a's read in state 0.
+    Delta counting_delta(3);
+    counting_delta.add(0, 'a', 0, 0);
+    counting_delta.add(0, 'a', 1, 1);
+    counting_delta.add(1, 'b', 2);
+
+    CounterSet counting_counters;
+    counting_counters.addCounter(0);
+
+    // Create Theta: annotations of the transitions, referenced by the annotation IDs of their targets.
+    Theta theta;
+    // Stay in state 0 while fewer than 3 a's have been read.
+    theta.add({ Annotation::testLess(0, 2), Annotation::increment(0) });
+    // Leave state 0 with the third a.
+    theta.add({ Annotation::testEqual(0, 2) });
+
+    Nfa counting_nfa(std::move(counting_delta), SparseSet<State>{ 0 }, SparseSet<State>{ 2 }, counting_counters);
+    counting_nfa.theta = std::move(theta);
+
+    std::string countingInputs[] = {"aab", "aaab", "aaaab"};
+    for (const auto& input : countingInputs) {
+        std::cout << "Counting input: \"" << input << "\" "
+                  << (counting_nfa.simulateWithCounters(input) ? "Accepted!" : "Rejected.") << "\n";
+    }
+
+    // Heap memory of the automaton, before and after dropping the slack left by the incremental construction.
+    std::cout << "Memory usage:\n";
+    counting_nfa.memoryUsage().print(std::cout);
+    counting_nfa.shrinkToFit();
+    std::cout << "Memory usage after shrinkToFit():\n";
+    counting_nfa.memoryUsage().print(std::cout);
+
+    // Counters of the hot paths, if compiled in (make STATS=1).
+    if constexpr (stats::ENABLED) {
+        std::cout << "Statistics:\n";
+        stats::get().print(std::cout);
+    }
+
     // End of simulation.
     return 0;
 }
@@ -0,0 +1,90 @@
+#include <map>
+
+#include "../../include/mata/nfa/bit-parallel-delta.hh"
+#include "../../include/mata/utils/stats.hh"
+
+using namespace mata::nfa;
+namespace stats = mata::utils::stats;
+
+template<size_t NumOfWords>
+BitParallelDelta<NumOfWords>::BitParallelDelta(const FrozenDelta& delta) : num_of_states_{ delta.numStates() } {
+    assert(num_of_states_ <= MAX_NUM_OF_STATES);
+
+    epsilon_closures_.resize(num_of_states_);
+    for (State state{ 0 }; state < num_of_states_; ++state) {
+        for (const State reachable : delta.getEpsilonClosure(state)) { epsilon_closures_[state].set(reachable); }
+    }
+    const auto has_trivial_closure{ [&](const State state) {
+        return delta.getEpsilonClosure(state).size() == 1;
+    } };
+
+    // Transitions over each byte symbol: the shift targets followed by the irregular successors of each state.
+    //  Epsilon transitions are in the closures only, so the symbol EPSILON (a NUL byte of the input) matches nothing.
+    std::vector<std::vector<Bits>> transitions_of_symbol(BYTE_ALPHABET_SIZE);
+    for (State source{ 0 }; source < num_of_states_; ++source) {
+        for (const FrozenDelta::SymbolPost symbol_post : delta.getStatePost(source)) {
+            if (symbol_post.symbol == EPSILON || symbol_post.symbol >= BYTE_ALPHABET_SIZE) { continue; }
+            std::vector<Bits>& transitions{ transitions_of_symbol[symbol_post.symbol] };
+            if (transitions.empty()) { transitions.resize(num_of_states_ + 1); }
+            for (const State target : symbol_post.targets) {
+                if (target == source + 1 && has_trivial_closure(target)) {
+                    transitions[0].set(target);
+                } else {
+                    transitions[source + 1] |= epsilon_closures_[target];
+                }
+            }
+        }
+    }
+
+    std::map<std::vector<Bits>, uint16_t> class_of_transitions{};
+    const std::vector<Bits> no_transitions(num_of_states_ + 1);
+    for (size_t symbol{ 0 }; symbol < BYTE_ALPHABET_SIZE; ++symbol) {
+        const std::vector<Bits>& transitions{ transitions_of_symbol[symbol].empty() ? no_transitions
+                                                                                    : transitions_of_symbol[symbol] };
+        const auto [it, inserted]{ class_of_transitions.try_emplace(transitions, classes_.size()) };
+        class_of_symbol_[symbol] = it->second;
+        if (!inserted) { continue; }
+
+        SymbolClass& symbol_class{ classes_.emplace_back() };
+        symbol_class.shift_targets = transitions[0];
+        for (State source{ 0 }; source < num_of_states_; ++source) {
+            if (transitions[source + 1].any()) { symbol_class.irregular_sources.set(source); }
+            successors_.push_back(transitions[source + 1]);
+        }
+    }
+}
+
+template<size_t NumOfWords>
+typename BitParallelDelta<NumOfWords>::Bits
+BitParallelDelta<NumOfWords>::epsilonClosure(const std::span<const State> states) const {
+    Bits closure{};
+    for (const State state : states) {
+        assert(state < MAX_NUM_OF_STATES);
+        if (state < num_of_states_) { closure |= epsilon_closures_[state]; }
+        else { closure.set(state); }
+    }
+    return closure;
+}
+
+template<size_t NumOfWords>
+bool BitParallelDelta<NumOfWords>::simulate(const std::span<const State> initial, const std::span<const State> final,
+                                            const std::string& input) const {
+    Bits current{ epsilonClosure(initial) };
+    if constexpr (stats::ENABLED) { stats::active_states(current.count()); }
+    for (const char c : input) {
+        if (!current.any()) { return false; }
+        current = post(current, toSymbol(c));
+        if constexpr (stats::ENABLED) { stats::active_states(current.count()); }
+    }
+
+    Bits final_states{};
+    for (const State state : final) {
+        assert(state < MAX_NUM_OF_STATES);
+        final_states.set(state);
+    }
+    return (current & final_states).any();
+}
+
+template class mata::nfa::BitParallelDelta<1>;
+template class mata::nfa::BitParallelDelta<2>;
+template class mata::nfa::BitParallelDelta<4>;
@@ -0,0 +1,463 @@
+// Counter-aware simulation of NFAs with counting sets.
+
+#include <map>
+#include <optional>
+#include <span>
+
+#include "../../include/mata/nfa/counting-set.hh"
+#include "../../include/mata/nfa/nfa.hh"
+#include "../../include/mata/nfa/valuation.hh"
+
+using namespace mata::nfa;
+namespace stats = mata::utils::stats;
+
+namespace {
+
+constexpr size_t NO_COUNTER{ UNDEFINED_ID };
+
+/// Static information about the counters of an NFA, computed once per simulation.
+class CounterAnalysis {
+public:
+    explicit CounterAnalysis(const Nfa& nfa);
+
+    /// Counter whose values are kept in a counting set in configurations of @p state, or @c NO_COUNTER.
+    size_t setCounter(const State state) const {
+        return state < num_of_states_ ? set_counter_[state] : NO_COUNTER;
+    }
+    /// Whether the value of @p counter in @p state can be tested before the counter is reset.
+    bool isLive(const State state, const size_t counter) const {
+        return state < num_of_states_ && live_[state * num_of_counters_ + counter];
+    }
+    /// Values of @p counter greater than the limit cannot be told apart from the limit by any guard.
+    CounterValue limit(const size_t counter) const { return limit_[counter]; }
+
+private:
+    size_t num_of_states_;
+    size_t num_of_counters_;
+    std::vector<size_t> set_counter_{};
+    std::vector<bool> live_{}; ///< Liveness of counter @c c in state @c q at index q * num_of_counters_ + c.
+    std::vector<CounterValue> limit_{};
+};
+
+CounterAnalysis::CounterAnalysis(const Nfa& nfa)
+    : num_of_states_{ nfa.delta.numStates() }, num_of_counters_{ nfa.counters.size() } {
+    const Theta& theta{ nfa.theta };
+    const Delta& delta{ nfa.delta };
+
+    // Guards compare counters with constants only, so values above the largest constant behave the same as long as
+    //  the counter is never decremented.
+    limit_.assign(num_of_counters_, 0);
+    std::vector<bool> decremented(num_of_counters_, false);
+    for (size_t annotation_id{ 0 }; annotation_id < theta.size(); ++annotation_id) {
+        for (const Annotation& annotation : theta[annotation_id]) {
+            if (annotation.isTest()) {
+                const auto [low, high]{ annotation.testedRange() };
+                const CounterValue largest{ high == std::numeric_limits<CounterValue>::max() ? low
+                                                                                              : std::max(low, high) };
+                limit_[annotation.counter_id] = std::max(limit_[annotation.counter_id], largest);
+            } else if (annotation.opcode == Annotation::Opcode::Decrement) {
+                decremented[annotation.counter_id] = true;
+            }
+        }
+    }
+    for (size_t counter{ 0 }; counter < num_of_counters_; ++counter) {
+        if (decremented[counter] || limit_[counter] == std::numeric_limits<CounterValue>::max()) {
+            limit_[counter] = std::numeric_limits<CounterValue>::max();
+        } else {
+            ++limit_[counter];
+        }
+    }
+
+    // A counter is live in a state if some transition from the state tests it before resetting it, or leaves it
+    //  unchanged or shifted into a state where it is live. A decrement tests the counter as well (it cannot go below
+    //  zero).
+    const auto tests_before_reset{ [&](const Target& target, const size_t counter) {
+        if (target.annotation_id == UNDEFINED_ID) { return std::optional<bool>{}; }
+        for (const Annotation& annotation : theta[target.annotation_id]) {
+            if (annotation.counter_id != counter) { continue; }
+            if (annotation.isTest() || annotation.opcode == Annotation::Opcode::Decrement) {
+                return std::optional<bool>{ true };
+            }
+            if (annotation.opcode == Annotation::Opcode::Reset) { return std::optional<bool>{ false }; }
+        }
+        return std::optional<bool>{};
+    } };
+    live_.assign(num_of_states_ * num_of_counters_, false);
+    for (bool changed{ true }; changed;) {
+        changed = false;
+        for (State source{ 0 }; source < num_of_states_; ++source) {
+            for (const SymbolPost& symbol_post : delta.getStatePost(source)) {
+                for (const Target& target : symbol_post.targets) {
+                    for (size_t counter{ 0 }; counter < num_of_counters_; ++counter) {
+                        if (live_[source * num_of_counters_ + counter]) { continue; }
+                        const std::optional<bool> tested{ tests_before_reset(target, counter) };
+                        if (tested.value_or(isLive(target.state, counter))) {
+                            live_[source * num_of_counters_ + counter] = true;
+                            changed = true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // The counting set of a state holds the first counter tested by a transition from the state.
+    set_counter_.assign(num_of_states_, NO_COUNTER);
+    for (State source{ 0 }; source < num_of_states_; ++source) {
+        for (const SymbolPost& symbol_post : delta.getStatePost(source)) {
+            for (const Target& target : symbol_post.targets) {
+                for (size_t counter{ 0 }; counter < std::min(num_of_counters_, set_counter_[source]); ++counter) {
+                    if (tests_before_reset(target, counter).value_or(false)) { set_counter_[source] = counter; }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Effect of a group of annotations on the counter kept in a counting set.
+ *
+ * The values in [low, high] pass the guards and are shifted by @c shift (down if @c negative), or replaced by
+ *  @c reset if the counter is reset. The shift is kept as a magnitude and a sign, so that it can reach any counter
+ *  value in either direction.
+ */
+struct Transfer {
+    CounterValue low{ 0 };
+    CounterValue high{ std::numeric_limits<CounterValue>::max() };
+    CounterValue shift{ 0 };
+    bool negative{ false };
+    std::optional<CounterValue> reset{};
+
+    bool empty() const { return low > high; }
+
+    void restrict(const Guard& guard) {
+        low = std::max(low, guard.low);
+        high = std::min(high, guard.high);
+    }
+
+    /// Apply the action @p annotation on @p counter (whose value is given by the transfer). @return False on failure.
+    bool apply(const Annotation& annotation, const CounterRegister& counter) {
+        if (reset) {
+            PackedRegister<> register_value{ *reset, counter };
+            return Theta::execute(annotation, register_value);
+        }
+        switch (annotation.opcode) {
+            case Annotation::Opcode::Increment: return shiftBy(annotation.operand, false);
+            // The guards keep only the values large enough to be decremented.
+            case Annotation::Opcode::Decrement: return shiftBy(annotation.operand, true);
+            case Annotation::Opcode::Reset: reset = counter.initial_value; break;
+            default: assert(false && "tests without a preceding reset are guards"); break;
+        }
+        return true;
+    }
+
+    /**
+     * Shift the values by @p amount, down if @p down, and keep only the values that stay within the range of counter
+     *  values, as the checked arithmetic of the registers does after each annotation.
+     * @return False if no value is left.
+     */
+    bool shiftBy(const CounterValue amount, const bool down) {
+        constexpr CounterValue MAX_VALUE{ std::numeric_limits<CounterValue>::max() };
+        if (negative == down || shift == 0) {
+            if (amount > MAX_VALUE - shift) { low = 1; high = 0; return false; }
+            shift += amount;
+            negative = down;
+        } else if (amount <= shift) {
+            shift -= amount;
+        } else {
+            shift = amount - shift;
+            negative = down;
+        }
+        negative = negative && shift != 0;
+        if (negative) { low = std::max(low, shift); }
+        else { high = std::min(high, MAX_VALUE - shift); }
+        return !empty();
+    }
+};
+
+/// Configuration without the values of the counter kept in the counting set (which is set to zero in the valuation).
+struct ConfigurationKey {
+    State state;
+    ValuationId valuation; ///< Interned in the valuation table of the configurations.
+
+    auto operator<=>(const ConfigurationKey&) const = default;
+};
+
+/**
+ * Configurations reached in one step of the simulation, merged by their keys.
+ *
+ * A configuration stands for the valuations with the value of the set counter of its state replaced by each value of
+ *  its counting set. Configurations of states without a set counter have empty counting sets.
+ *
+ * Valuations are interned, so configurations sharing a valuation store it once and keys are compared by IDs.
+ */
+class Configurations {
+public:
+    explicit Configurations(const size_t num_of_counters) : valuations_{ num_of_counters } {}
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    ConfigurationKey key(const size_t index) const { return entries_[index].key; }
+    /// Valuation of the configuration at @p index, valid until a configuration is added.
+    std::span<const CounterValue> valuation(const size_t index) const {
+        return valuations_[entries_[index].key.valuation];
+    }
+    CountingSet& values(const size_t index) { return entries_[index].values; }
+
+    /// Add the configuration, uniting its values with the configuration of the same key if there is one.
+    void add(const State state, const std::span<const CounterValue> valuation, CountingSet&& values) {
+        const ConfigurationKey key{ state, valuations_.intern(valuation) };
+        const auto [it, inserted]{ index_.try_emplace(key, entries_.size()) };
+        if (inserted) {
+            entries_.push_back({ key, std::move(values) });
+            pending_.push_back(it->second);
+        } else if (entries_[it->second].values.insert(std::move(values))) {
+            pending_.push_back(it->second);
+        }
+    }
+
+    /**
+     * Call @p function on the indices of the configurations of each state, given as a span.
+     * @p function may modify the counting sets, but must not add configurations.
+     */
+    template<class Function>
+    void forEachState(Function&& function) {
+        batch_.clear();
+        for (const auto& [configuration_key, index] : index_) {
+            if (!batch_.empty() && configuration_key.state != key(batch_.front()).state) {
+                function(std::span<const size_t>{ batch_ });
+                batch_.clear();
+            }
+            batch_.push_back(index);
+        }
+        if (!batch_.empty()) { function(std::span<const size_t>{ batch_ }); }
+    }
+
+    /// Take the index of a configuration added or extended since the last call, if any.
+    std::optional<size_t> takePending() {
+        if (pending_.empty()) { return std::nullopt; }
+        const size_t index{ pending_.back() };
+        pending_.pop_back();
+        return index;
+    }
+
+    void clear() {
+        index_.clear();
+        entries_.clear();
+        pending_.clear();
+        valuations_.clear();
+    }
+
+private:
+    struct Entry {
+        ConfigurationKey key;
+        CountingSet values;
+    };
+
+    ValuationTable valuations_;
+    std::map<ConfigurationKey, size_t> index_{};
+    std::vector<Entry> entries_{};
+    std::vector<size_t> pending_{};
+    std::vector<size_t> batch_{};
+};
+
+class CountingSimulation {
+public:
+    explicit CountingSimulation(const Nfa& nfa) : nfa_{ nfa }, analysis_{ nfa } {}
+
+    /// Add the configuration of @p state with the concrete valuation @p valuation, which is normalized in place.
+    void addConcrete(const State state, const std::span<CounterValue> valuation, Configurations& result) const {
+        const size_t counter{ analysis_.setCounter(state) };
+        CountingSet values{};
+        if (counter != NO_COUNTER) { values.insert(std::min(valuation[counter], analysis_.limit(counter))); }
+        normalize(state, valuation, counter);
+        result.add(state, valuation, std::move(values));
+    }
+
+    /**
+     * Add to @p result the configurations reached over @p symbol from the configurations at @p batch of @p current,
+     *  all of the same state.
+     *
+     * The guards of each transition are evaluated for the whole batch first, over the counter values packed counter by
+     *  counter, and only the configurations passing them are expanded.
+     */
+    void post(Configurations& current, const std::span<const size_t> batch, const Symbol symbol,
+              Configurations& result) {
+        const State state{ current.key(batch.front()).state };
+        // A NUL byte of the input (the symbol EPSILON) matches no transition.
+        if (state >= nfa_.delta.numStates() || symbol == EPSILON) { return; }
+        const StatePost& state_post{ nfa_.delta.getStatePost(state) };
+        const auto symbol_post{ state_post.find(symbol) };
+        if (symbol_post == state_post.end()) { return; }
+
+        const size_t counter{ analysis_.setCounter(state) };
+        const size_t batch_size{ batch.size() };
+        columns_.resize(nfa_.counters.size() * batch_size);
+        packed_.assign(nfa_.counters.size(), false);
+        const auto column{ [&](const size_t counter_id) {
+            CounterValue* const values{ columns_.data() + counter_id * batch_size };
+            if (!packed_[counter_id]) {
+                for (size_t i{ 0 }; i < batch_size; ++i) { values[i] = current.valuation(batch[i])[counter_id]; }
+                packed_[counter_id] = true;
+            }
+            return values;
+        } };
+
+        const auto& targets{ symbol_post->targets };
+        stats::add(&stats::Stats::transitions_examined, targets.size() * batch_size);
+        for (auto target{ targets.begin() }; target != targets.end(); ++target) {
+            passed_.assign(batch_size, 1);
+            if (target->annotation_id != UNDEFINED_ID) {
+                for (const Guard& guard : nfa_.theta.guards(target->annotation_id)) {
+                    // Guards of the set counter restrict the counting sets instead.
+                    if (guard.counter_id == counter) { continue; }
+                    guard.test(column(guard.counter_id), batch_size, passed_.data());
+                }
+            }
+            // The last transition may take over the counting sets instead of copying them.
+            const bool consume{ std::next(target) == targets.end() };
+            for (size_t i{ 0 }; i < batch_size; ++i) {
+                if (!passed_[i]) { continue; }
+                takeTransition(state, current.valuation(batch[i]), current.values(batch[i]), consume, true, *target,
+                               result);
+            }
+        }
+    }
+
+    /// Add all configurations reachable from the pending configurations of @p configurations over epsilon transitions.
+    void epsilonClosure(Configurations& configurations) {
+        while (const std::optional<size_t> index{ configurations.takePending() }) {
+            const State state{ configurations.key(*index).state };
+            if (state >= nfa_.delta.numStates()) { continue; }
+            const StatePost& state_post{ nfa_.delta.getStatePost(state) };
+            const auto symbol_post{ state_post.find(EPSILON) };
+            if (symbol_post == state_post.end()) { continue; }
+            // Adding to the configurations may extend or move the counting set, so work on a copy.
+            CountingSet values{ configurations.values(*index) };
+            stats::add(&stats::Stats::transitions_examined, symbol_post->targets.size());
+            for (const Target& target : symbol_post->targets) {
+                takeTransition(state, configurations.valuation(*index), values, false, false, target, configurations);
+            }
+        }
+    }
+
+private:
+    /**
+     * Add to @p result the configurations reached from the configuration of @p state with @p valuation and @p values
+     *  over a transition to @p target. @p valuation may be stored in @p result; it is copied before anything is added.
+     *  If @p consume, @p values may be moved from. If @p guards_passed, the guards of counters other than the set
+     *  counter are known to hold.
+     */
+    void takeTransition(const State state, const std::span<const CounterValue> valuation, CountingSet& values,
+                        const bool consume, const bool guards_passed, const Target& target, Configurations& result) {
+        const size_t counter{ analysis_.setCounter(state) };
+        Transfer transfer{};
+        if (target.annotation_id != UNDEFINED_ID) {
+            for (const Guard& guard : nfa_.theta.guards(target.annotation_id)) {
+                if (guard.counter_id == counter) { transfer.restrict(guard); }
+                else if (!guards_passed && !guard.test(valuation[guard.counter_id])) { return; }
+            }
+            if (transfer.empty()) { return; }
+        }
+        std::vector<CounterValue>& counters{ valuation_ };
+        counters.assign(valuation.begin(), valuation.end());
+        if (target.annotation_id != UNDEFINED_ID) {
+            for (const Annotation& annotation : nfa_.theta.actions(target.annotation_id)) {
+                const CounterRegister& layout{ nfa_.counters[annotation.counter_id] };
+                if (annotation.counter_id == counter) {
+                    if (!transfer.apply(annotation, layout)) { return; }
+                    continue;
+                }
+                PackedRegister<> counter_register{ counters[annotation.counter_id], layout };
+                if (!Theta::execute(annotation, counter_register)) { return; }
+            }
+        }
+
+        if (counter == NO_COUNTER) { return addConcrete(target.state, counters, result); }
+        if (!values.intersects(transfer.low, transfer.high)) { return; }
+        const size_t target_counter{ analysis_.setCounter(target.state) };
+        if (transfer.reset || (target_counter != counter && !analysis_.isLive(target.state, counter))) {
+            // All values lead to the same configuration.
+            counters[counter] = transfer.reset.value_or(nfa_.counters[counter].initial_value);
+            return addConcrete(target.state, counters, result);
+        }
+
+        CountingSet successors{ consume ? std::move(values) : values.slice(transfer.low, transfer.high) };
+        successors.keepRange(transfer.low, transfer.high);
+        if (transfer.negative) { successors.decrementAll(transfer.shift); }
+        else { successors.incrementAll(transfer.shift); }
+
+        if (target_counter == counter) {
+            successors.saturate(analysis_.limit(counter));
+            normalize(target.state, counters, counter);
+            result.add(target.state, counters, std::move(successors));
+        } else {
+            // The counter leaves the counting set: expand the configuration into the valuations it stands for.
+            successors.forEach([&](const CounterValue value) {
+                expanded_.assign(counters.begin(), counters.end());
+                expanded_[counter] = value;
+                addConcrete(target.state, expanded_, result);
+            });
+        }
+    }
+
+    /**
+     * Bring @p valuation of a configuration of @p state to a canonical form, so that configurations that behave the
+     *  same are merged: dead counters are reset, values above the limit are saturated and the value of @p set_counter
+     *  (kept in the counting set) is zeroed.
+     */
+    void normalize(const State state, const std::span<CounterValue> valuation, const size_t set_counter) const {
+        for (size_t counter{ 0 }; counter < valuation.size(); ++counter) {
+            CounterValue& value{ valuation[counter] };
+            if (counter == set_counter) { value = 0; }
+            else if (!analysis_.isLive(state, counter)) { value = nfa_.counters[counter].initial_value; }
+            else { value = std::min(value, analysis_.limit(counter)); }
+        }
+    }
+
+    const Nfa& nfa_;
+    const CounterAnalysis analysis_;
+    std::vector<CounterValue> valuation_{}; ///< Valuation of the configuration being built by a transition.
+    std::vector<CounterValue> expanded_{}; ///< Valuation of a configuration expanded from a counting set.
+    std::vector<CounterValue> columns_{}; ///< Counter values of a batch, counter by counter.
+    std::vector<bool> packed_{}; ///< Whether the column of a counter has been filled for the current batch.
+    std::vector<uint8_t> passed_{}; ///< Whether the configurations of a batch pass the guards of a transition.
+};
+
+} // namespace.
+
+bool Nfa::simulateWithCounters(const std::string& input) const {
+    stats::start_simulation();
+    CountingSimulation simulation{ *this };
+    Configurations current{ counters.size() };
+    Configurations next{ counters.size() };
+
+    // IDs and initial values of the counters are kept once in the counter registers of the automaton.
+    std::vector<CounterValue> initial_valuation(counters.size());
+    for (size_t counter{ 0 }; counter < counters.size(); ++counter) {
+        initial_valuation[counter] = counters[counter].initial_value;
+    }
+    for (const State state : initial) {
+        std::vector<CounterValue> valuation{ initial_valuation };
+        simulation.addConcrete(state, valuation, current);
+    }
+    simulation.epsilonClosure(current);
+    stats::active_states(current.size());
+
+    for (const char c : input) {
+        if (current.empty()) { return false; }
+        const Symbol symbol{ toSymbol(c) };
+        next.clear();
+        current.forEachState([&](const std::span<const size_t> batch) {
+            simulation.post(current, batch, symbol, next);
+        });
+        simulation.epsilonClosure(next);
+        std::swap(current, next);
+        stats::active_states(current.size());
+    }
+
+    for (size_t index{ 0 }; index < current.size(); ++index) {
+        if (final.contains(current.key(index).state)) { return true; }
+    }
+    return false;
+}
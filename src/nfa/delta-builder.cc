@@ -0,0 +1,116 @@
+#include <bit>
+#include <cstdint>
+
+#include "../../include/mata/nfa/delta-builder.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+/// Sort @p keys using LSD radix sort over the lowest @p num_of_bits bits. @p buffer is used as scratch space.
+void radix_sort(std::vector<uint64_t>& keys, std::vector<uint64_t>& buffer, const unsigned num_of_bits) {
+    constexpr unsigned DIGIT_BITS{ 11 };
+    constexpr size_t NUM_OF_BUCKETS{ size_t{ 1 } << DIGIT_BITS };
+    constexpr uint64_t DIGIT_MASK{ NUM_OF_BUCKETS - 1 };
+
+    buffer.resize(keys.size());
+    std::vector<size_t> counts(NUM_OF_BUCKETS);
+    for (unsigned shift{ 0 }; shift < num_of_bits; shift += DIGIT_BITS) {
+        std::fill(counts.begin(), counts.end(), 0);
+        for (const uint64_t key : keys) { ++counts[(key >> shift) & DIGIT_MASK]; }
+        // All keys share the digit, the pass would not change anything.
+        if (counts[(keys.front() >> shift) & DIGIT_MASK] == keys.size()) { continue; }
+
+        size_t offset{ 0 };
+        for (size_t& count : counts) {
+            const size_t bucket_size{ count };
+            count = offset;
+            offset += bucket_size;
+        }
+        for (const uint64_t key : keys) { buffer[counts[(key >> shift) & DIGIT_MASK]++] = key; }
+        keys.swap(buffer);
+    }
+}
+
+/**
+ * Fill @p delta from sorted and deduplicated transitions.
+ * @param[in] size Number of transitions.
+ * @param[in] get Function returning the (source, symbol, target) of the transition at the given index.
+ */
+template<class Get>
+void emit(std::pmr::vector<StatePost>& state_posts, const size_t size, const Get& get) {
+    size_t index{ 0 };
+    while (index < size) {
+        const State source{ get(index).source };
+        size_t source_end{ index };
+        size_t num_of_symbol_posts{ 0 };
+        for (Symbol last_symbol{ 0 }; source_end < size && get(source_end).source == source; ++source_end) {
+            if (num_of_symbol_posts == 0 || get(source_end).symbol != last_symbol) {
+                last_symbol = get(source_end).symbol;
+                ++num_of_symbol_posts;
+            }
+        }
+
+        StatePost& state_post{ state_posts[source] };
+        state_post.reserve(num_of_symbol_posts);
+        while (index < source_end) {
+            const Symbol symbol{ get(index).symbol };
+            size_t symbol_end{ index };
+            while (symbol_end < source_end && get(symbol_end).symbol == symbol) { ++symbol_end; }
+
+            SymbolPost& symbol_post{ state_post.emplace_back(symbol) };
+            symbol_post.targets.reserve(symbol_end - index);
+            for (; index < symbol_end; ++index) { symbol_post.targets.push_back(get(index).target); }
+        }
+    }
+}
+
+} // namespace.
+
+Delta DeltaBuilder::build(const size_t num_of_states, std::pmr::memory_resource* resource) {
+    Delta delta{ transitions_.empty() ? num_of_states : std::max(num_of_states, max_state_ + 1), resource };
+    if (transitions_.empty()) { return delta; }
+
+    const unsigned state_bits{ static_cast<unsigned>(std::max<int>(std::bit_width(max_state_), 1)) };
+    const unsigned symbol_bits{ static_cast<unsigned>(std::max<int>(std::bit_width(max_symbol_), 1)) };
+    if (sorted_) {
+        emit(delta.state_posts_, transitions_.size(), [&](const size_t index) { return transitions_[index]; });
+        transitions_ = {};
+    } else if (2 * state_bits + symbol_bits <= 64) {
+        // Pack (source, symbol, target) into a single key, ordered as the tuple.
+        const unsigned symbol_shift{ state_bits };
+        const unsigned source_shift{ state_bits + symbol_bits };
+        std::vector<uint64_t> keys{};
+        keys.reserve(transitions_.size());
+        for (const Transition& transition : transitions_) {
+            keys.push_back((static_cast<uint64_t>(transition.source) << source_shift)
+                           | (static_cast<uint64_t>(transition.symbol) << symbol_shift)
+                           | static_cast<uint64_t>(transition.target));
+        }
+        transitions_ = {};
+
+        std::vector<uint64_t> buffer{};
+        radix_sort(keys, buffer, 2 * state_bits + symbol_bits);
+        buffer = {};
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        const uint64_t state_mask{ (uint64_t{ 1 } << state_bits) - 1 };
+        const uint64_t symbol_mask{ (uint64_t{ 1 } << symbol_bits) - 1 };
+        emit(delta.state_posts_, keys.size(), [&](const size_t index) {
+            const uint64_t key{ keys[index] };
+            return Transition{ static_cast<State>(key >> source_shift),
+                               static_cast<Symbol>((key >> symbol_shift) & symbol_mask),
+                               static_cast<State>(key & state_mask) };
+        });
+    } else {
+        std::sort(transitions_.begin(), transitions_.end());
+        transitions_.erase(std::unique(transitions_.begin(), transitions_.end()), transitions_.end());
+        emit(delta.state_posts_, transitions_.size(), [&](const size_t index) { return transitions_[index]; });
+        transitions_ = {};
+    }
+
+    max_state_ = 0;
+    max_symbol_ = 0;
+    sorted_ = true;
+    return delta;
+}
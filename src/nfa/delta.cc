@@ -1,4 +1,5 @@
 #include "../../include/mata/nfa/delta.hh"
+#include "../../include/mata/utils/sparse-set.hh"
 
 using namespace mata::nfa;
 
@@ -6,6 +7,12 @@ using namespace mata::nfa;
 SymbolPost part.
 */
 
+SymbolPost::SymbolPost(const Symbol symbol, const StateSet& targets, const allocator_type& allocator)
+    : symbol{ symbol }, targets(allocator) {
+    this->targets.reserve(targets.size());
+    for (const State state : targets) { this->targets.push_back(Target{ state, UNDEFINED_ID }); }
+}
+
 SymbolPost& SymbolPost::operator=(SymbolPost&& rhs) noexcept {
     if (*this != rhs) {
         symbol = rhs.symbol;
@@ -14,24 +21,39 @@ SymbolPost& SymbolPost::operator=(SymbolPost&& rhs) noexcept {
     return *this;
 }
 
-void SymbolPost::insert(State state) {
-    if(targets.empty() || targets.back() < state) {
-        targets.push_back(state);
+void SymbolPost::insert(const Target& target) {
+    if(targets.empty() || targets.back() < target) {
+        targets.push_back(target);
         return;
     }
     // Find the place where to put the element (if not present).
     // insert to OrdVector without the searching of a proper position inside insert(const Key&x).
-    auto it = std::lower_bound(targets.begin(), targets.end(), state);
-    if (it == targets.end() || *it != state) {
-        targets.insert(it, state);
+    auto it = utils::branchless_lower_bound(targets.begin(), targets.end(), target);
+    if (it == targets.end() || *it != target) {
+        targets.insert(it, target);
     }
 }
 
-// TODO: slow! This should be doing merge, not inserting one by one.
 void SymbolPost::insert(const StateSet& states) {
-    for (State state : states) {
-        insert(state);
-    }
+    // Plain states are merged as targets without an annotation, i.e., by the same (state, annotation_id) ordering as
+    //  insert(const Target&).
+    targets.insert(states);
+}
+
+/*
+StatePost part.
+*/
+
+DeltaMemoryUsage StatePost::memoryUsage() const {
+    DeltaMemoryUsage usage{};
+    usage.symbol_posts = super::memory_usage();
+    for (const SymbolPost& symbol_post : *this) { usage.targets += symbol_post.targets.memory_usage(); }
+    return usage;
+}
+
+void StatePost::shrinkToFit() {
+    for (SymbolPost& symbol_post : *this) { symbol_post.targets.shrink_to_fit(); }
+    super::shrink_to_fit();
 }
 
 /*
@@ -39,7 +61,15 @@ Delta part.
 */
 
 void Delta::add(State source, Symbol symbol, State target) {
-    const State max_state{ std::max(source, target) };
+    add(source, symbol, target, UNDEFINED_ID);
+}
+
+void Delta::add(State source, Symbol symbol, State target_state, size_t annotation_id) {
+    const Target target{ target_state, annotation_id };
+    const State max_state{ std::max(source, target_state) };
+    if (symbol == EPSILON || max_state >= state_posts_.size()) {
+        invalidateEpsilonClosures();
+    }
     if (max_state >= state_posts_.size()) {
         reserve_on_insert(state_posts_, max_state);
         state_posts_.resize(max_state + 1);
@@ -52,7 +82,7 @@ void Delta::add(State source, Symbol symbol, State target) {
     } else if (state_transitions.back().symbol < symbol) {
         state_transitions.insert({ symbol, target });
     } else {
-        const auto symbol_transitions{ state_transitions.find(SymbolPost{ symbol }) };
+        const auto symbol_transitions{ state_transitions.find(symbol) };
         if (symbol_transitions != state_transitions.end()) {
             // Add transition with symbol already used on transitions from state_from.
             symbol_transitions->insert(target);
@@ -70,6 +100,9 @@ void Delta::add(const State source, const Symbol symbol, const StateSet& targets
     }
 
     const State max_state{ std::max(source, targets.back()) };
+    if (symbol == EPSILON || max_state >= state_posts_.size()) {
+        invalidateEpsilonClosures();
+    }
     if (max_state >= state_posts_.size()) {
         reserve_on_insert(state_posts_, max_state + 1);
         state_posts_.resize(max_state + 1);
@@ -94,3 +127,78 @@ void Delta::add(const State source, const Symbol symbol, const StateSet& targets
         }
     }
 }
+
+void Delta::searchEpsilonClosure(utils::SparseSet<State>& states) const {
+    // Newly inserted states are appended to the dense part, so iterating by index explores them as well.
+    for (size_t i{ 0 }; i < states.size(); ++i) {
+        const State state{ states.begin()[static_cast<long>(i)] };
+        if (state >= state_posts_.size()) { continue; }
+        const StatePost& post{ state_posts_[state] };
+        if (post.empty() || post.begin()->symbol != EPSILON) { continue; }
+        for (const Target& target : post.begin()->targets) {
+            states.insert(target.state);
+        }
+    }
+}
+
+void Delta::epsilonClosure(utils::SparseSet<State>& states) const {
+    if (!epsilon_closures_valid_) {
+        searchEpsilonClosure(states);
+        return;
+    }
+    // Closures are transitive, so only the states present at the start need to be expanded.
+    for (size_t i{ 0 }, size{ states.size() }; i < size; ++i) {
+        const State state{ states.begin()[static_cast<long>(i)] };
+        if (state >= state_posts_.size()) { continue; }
+        for (const State reachable : getEpsilonClosure(state)) {
+            states.insert(reachable);
+        }
+    }
+}
+
+void Delta::computeEpsilonClosures() {
+    if (epsilon_closures_valid_) { return; }
+
+    const size_t num_of_states{ state_posts_.size() };
+    epsilon_closure_offsets_.clear();
+    epsilon_closure_offsets_.reserve(num_of_states + 1);
+    epsilon_closure_states_.clear();
+    epsilon_closure_states_.reserve(num_of_states);
+
+    utils::SparseSet<State> closure(num_of_states);
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        epsilon_closure_offsets_.push_back(epsilon_closure_states_.size());
+
+        const StatePost& state_post{ state_posts_[state] };
+        if (state_post.empty() || state_post.begin()->symbol != EPSILON) {
+            // The most common case: no epsilon transitions leave the state.
+            epsilon_closure_states_.push_back(state);
+            continue;
+        }
+
+        closure.clear();
+        closure.insert(state);
+        searchEpsilonClosure(closure);
+        const size_t begin{ epsilon_closure_states_.size() };
+        epsilon_closure_states_.insert(epsilon_closure_states_.end(), closure.begin(), closure.end());
+        std::sort(epsilon_closure_states_.begin() + static_cast<long>(begin), epsilon_closure_states_.end());
+    }
+    epsilon_closure_offsets_.push_back(epsilon_closure_states_.size());
+    epsilon_closures_valid_ = true;
+}
+
+DeltaMemoryUsage Delta::memoryUsage() const {
+    DeltaMemoryUsage usage{};
+    usage.state_posts = utils::vector_memory_usage(state_posts_);
+    for (const StatePost& state_post : state_posts_) { usage += state_post.memoryUsage(); }
+    usage.epsilon_closures = utils::vector_memory_usage(epsilon_closure_offsets_)
+                             + utils::vector_memory_usage(epsilon_closure_states_);
+    return usage;
+}
+
+void Delta::shrinkToFit() {
+    for (StatePost& state_post : state_posts_) { state_post.shrinkToFit(); }
+    state_posts_.shrink_to_fit();
+    epsilon_closure_offsets_.shrink_to_fit();
+    epsilon_closure_states_.shrink_to_fit();
+}
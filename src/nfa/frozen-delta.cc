@@ -0,0 +1,96 @@
+#include "../../include/mata/nfa/frozen-delta.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+/// Arrays of a frozen delta built from a @c Delta.
+struct Storage {
+    std::vector<size_t> state_offsets{};
+    std::vector<Symbol> symbols{};
+    std::vector<size_t> target_offsets{};
+    std::vector<State> targets{};
+    std::vector<size_t> epsilon_closure_offsets{};
+    std::vector<State> epsilon_closure_states{};
+    std::vector<uint32_t> dense_table_of_state{};
+    std::vector<uint16_t> dense_slots{};
+};
+
+} // namespace.
+
+FrozenDelta::FrozenDelta(const Delta& delta, const size_t dense_threshold) {
+    const size_t num_of_states{ delta.numStates() };
+    const std::shared_ptr<Storage> storage{ std::make_shared<Storage>() };
+    auto& [state_offsets, symbols, target_offsets, targets, epsilon_closure_offsets, epsilon_closure_states,
+           dense_table_of_state, dense_slots]{ *storage };
+
+    size_t num_of_symbol_posts{ 0 };
+    size_t num_of_transitions{ 0 };
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        for (const mata::nfa::SymbolPost& symbol_post : delta.getStatePost(state)) {
+            ++num_of_symbol_posts;
+            num_of_transitions += symbol_post.targets.size();
+        }
+    }
+
+    state_offsets.reserve(num_of_states + 1);
+    symbols.reserve(num_of_symbol_posts);
+    target_offsets.reserve(num_of_symbol_posts + 1);
+    targets.reserve(num_of_transitions);
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        state_offsets.push_back(symbols.size());
+        for (const mata::nfa::SymbolPost& symbol_post : delta.getStatePost(state)) {
+            symbols.push_back(symbol_post.symbol);
+            target_offsets.push_back(targets.size());
+            for (const Target& target : symbol_post.targets) {
+                targets.push_back(target.state);
+            }
+        }
+    }
+    state_offsets.push_back(symbols.size());
+    target_offsets.push_back(targets.size());
+
+    // Dense tables for states with high out-degree. Symbols are sorted, so the byte symbols come first and the slot
+    //  (the offset of the symbol post within the state) is always below BYTE_ALPHABET_SIZE.
+    dense_table_of_state.assign(num_of_states, NO_DENSE_TABLE);
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        const size_t first{ state_offsets[state] };
+        const size_t last_byte{ static_cast<size_t>(
+            std::lower_bound(symbols.begin() + static_cast<long>(first),
+                             symbols.begin() + static_cast<long>(state_offsets[state + 1]),
+                             static_cast<Symbol>(BYTE_ALPHABET_SIZE)) - symbols.begin()) };
+        if (last_byte - first < std::max<size_t>(dense_threshold, 1)) { continue; }
+        dense_table_of_state[state] = static_cast<uint32_t>(dense_slots.size() / BYTE_ALPHABET_SIZE);
+        const size_t table_begin{ dense_slots.size() };
+        dense_slots.resize(table_begin + BYTE_ALPHABET_SIZE, NO_DENSE_SLOT);
+        for (size_t index{ first }; index < last_byte; ++index) {
+            dense_slots[table_begin + symbols[index]] = static_cast<uint16_t>(index - first);
+        }
+    }
+
+    // The closures are taken from the closure index of the delta if it is built, searched otherwise.
+    epsilon_closure_offsets.reserve(num_of_states + 1);
+    utils::SparseSet<State> closure(num_of_states);
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        epsilon_closure_offsets.push_back(epsilon_closure_states.size());
+        closure.clear();
+        closure.insert(state);
+        delta.epsilonClosure(closure);
+        const size_t begin{ epsilon_closure_states.size() };
+        epsilon_closure_states.insert(epsilon_closure_states.end(), closure.begin(), closure.end());
+        std::sort(epsilon_closure_states.begin() + static_cast<long>(begin), epsilon_closure_states.end());
+    }
+    epsilon_closure_offsets.push_back(epsilon_closure_states.size());
+
+    arrays_ = { state_offsets, symbols, target_offsets, targets, epsilon_closure_offsets, epsilon_closure_states,
+                dense_table_of_state, dense_slots };
+    storage_ = storage;
+}
+
+size_t FrozenDelta::findSymbolPost(const size_t first, const size_t last, const Symbol symbol) const {
+    const auto symbols_begin{ arrays_.symbols.begin() };
+    const auto it{ utils::branchless_lower_bound(symbols_begin + static_cast<long>(first),
+                                                 symbols_begin + static_cast<long>(last), symbol) };
+    if (it == symbols_begin + static_cast<long>(last) || *it != symbol) { return last; }
+    return static_cast<size_t>(it - symbols_begin);
+}
@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <random>
+#include <stdexcept>
+
+#include "../../include/mata/nfa/delta-builder.hh"
+#include "../../include/mata/nfa/generator.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+/**
+ * Source of random numbers giving the same sequences with every standard library: the engine is fully specified by
+ *  the standard, the distributions of the standard library are not, so they are not used.
+ */
+class Random {
+public:
+    explicit Random(const uint64_t seed) : engine_{ seed } {}
+
+    /// Uniform integer in [0, @p bound).
+    uint64_t below(const uint64_t bound) { return engine_() % bound; }
+    /// Uniform real number in [0, 1).
+    double unit() { return static_cast<double>(engine_() >> 11) * 0x1p-53; }
+    bool chance(const double probability) { return unit() < probability; }
+
+    template<class T>
+    void shuffle(std::vector<T>& values) {
+        for (size_t i{ values.size() }; i > 1; --i) { std::swap(values[i - 1], values[below(i)]); }
+    }
+
+private:
+    std::mt19937_64 engine_;
+};
+
+size_t sampleDegree(const GeneratorParameters& parameters, Random& random) {
+    const double mean{ std::max(0.0, parameters.out_degree) };
+    double degree{};
+    switch (parameters.distribution) {
+        case DegreeDistribution::Constant: degree = mean; break;
+        case DegreeDistribution::Uniform:
+            degree = static_cast<double>(random.below(static_cast<uint64_t>(std::llround(2 * mean)) + 1));
+            break;
+        case DegreeDistribution::Geometric:
+            // Number of failures before the first success with the success probability 1 / (1 + mean).
+            degree = mean == 0 ? 0 : std::floor(std::log(1 - random.unit()) / std::log(mean / (1 + mean)));
+            break;
+        case DegreeDistribution::PowerLaw: {
+            // Pareto distribution with the shape 2.5, scaled to the mean.
+            constexpr double SHAPE{ 2.5 };
+            degree = mean * (SHAPE - 1) / SHAPE * std::pow(1 - random.unit(), -1 / SHAPE);
+            break;
+        }
+    }
+    const double max_degree{ static_cast<double>(parameters.num_of_states * (parameters.alphabet_size + 1)) };
+    return static_cast<size_t>(std::llround(std::min(degree, max_degree)));
+}
+
+/// Random group of annotations of a counting constraint; only tests if @p epsilon.
+std::vector<Annotation> randomAnnotations(const GeneratorParameters& parameters, const bool epsilon,
+                                          Random& random) {
+    const size_t counter{ random.below(parameters.num_of_counters) };
+    const CounterValue bound{ 1 + random.below(std::max<CounterValue>(1, parameters.max_bound)) };
+    if (epsilon) {
+        switch (random.below(3)) {
+            case 0: return { Annotation::testLess(counter, bound) };
+            case 1: return { Annotation::testGreaterEqual(counter, bound) };
+            default: return { Annotation::testInRange(counter, random.below(bound + 1), bound) };
+        }
+    }
+    switch (random.below(parameters.decrements ? 6 : 5)) {
+        case 0: return { Annotation::testLess(counter, bound), Annotation::increment(counter) };
+        case 1: return { Annotation::testGreaterEqual(counter, bound), Annotation::reset(counter) };
+        case 2: return { Annotation::testInRange(counter, random.below(bound + 1), bound) };
+        case 3: return { Annotation::reset(counter) };
+        case 4: return { Annotation::increment(counter) };
+        default: return { Annotation::testGreaterEqual(counter, 1), Annotation::decrement(counter) };
+    }
+}
+
+bool accepts(const Nfa& nfa, const std::string& word) {
+    return nfa.theta.empty() ? nfa.simulate(word) : nfa.simulateWithCounters(word);
+}
+
+/// Numbers of symbols needed to reach a final state from each state, ignoring counters (@c MAX_SIZE_T if none).
+std::vector<size_t> distancesToFinal(const Nfa& nfa) {
+    const size_t num_of_states{ nfa.numStates() };
+    std::vector<std::vector<std::pair<State, bool>>> predecessors(num_of_states);
+    for (State source{ 0 }; source < nfa.delta.numStates(); ++source) {
+        for (const SymbolPost& symbol_post : nfa.delta.getStatePost(source)) {
+            for (const Target& target : symbol_post.targets) {
+                predecessors[target.state].emplace_back(source, symbol_post.symbol == EPSILON);
+            }
+        }
+    }
+
+    // Breadth-first search with epsilon transitions of length zero.
+    std::vector<size_t> distances(num_of_states, MAX_SIZE_T);
+    std::deque<State> queue{};
+    for (const State state : nfa.final) {
+        distances[state] = 0;
+        queue.push_back(state);
+    }
+    while (!queue.empty()) {
+        const State state{ queue.front() };
+        queue.pop_front();
+        for (const auto& [predecessor, epsilon] : predecessors[state]) {
+            const size_t distance{ distances[state] + (epsilon ? 0 : 1) };
+            if (distance >= distances[predecessor]) { continue; }
+            distances[predecessor] = distance;
+            if (epsilon) { queue.push_front(predecessor); } else { queue.push_back(predecessor); }
+        }
+    }
+    return distances;
+}
+
+/// Read a word along a random run of @p nfa; empty if the run gets stuck.
+std::optional<std::string> randomRun(const Nfa& nfa, const std::vector<size_t>& distances,
+                                     const std::vector<State>& initial, const size_t length, Random& random) {
+    struct Candidate {
+        Symbol symbol;
+        const Target* target;
+        size_t distance;
+    };
+    std::vector<Candidate> candidates{};
+    State state{ initial[random.below(initial.size())] };
+    CounterSet counters{ nfa.counters };
+    std::string word{};
+    const size_t max_steps{ 4 * (length + nfa.numStates()) };
+
+    for (size_t step{ 0 }; step < max_steps; ++step) {
+        const bool heading_to_final{ word.size() >= length };
+        if (heading_to_final && nfa.final.contains(state)) { return word; }
+
+        candidates.clear();
+        if (state < nfa.delta.numStates()) {
+            for (const SymbolPost& symbol_post : nfa.delta.getStatePost(state)) {
+                for (const Target& target : symbol_post.targets) {
+                    if (distances[target.state] == MAX_SIZE_T) { continue; }
+                    candidates.push_back({ symbol_post.symbol, &target, distances[target.state] });
+                }
+            }
+        }
+        random.shuffle(candidates);
+        if (heading_to_final) {
+            std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& lhs, const Candidate& rhs) {
+                return lhs.distance < rhs.distance;
+            });
+        }
+
+        // Take the first candidate allowed by the counters.
+        const Candidate* taken{ nullptr };
+        for (const Candidate& candidate : candidates) {
+            if (candidate.target->annotation_id == UNDEFINED_ID) { taken = &candidate; break; }
+            CounterSet updated{ counters };
+            if (nfa.theta.execute(candidate.target->annotation_id, updated)) {
+                counters = std::move(updated);
+                taken = &candidate;
+                break;
+            }
+        }
+        if (taken == nullptr) { return std::nullopt; }
+        if (taken->symbol != EPSILON) { word.push_back(static_cast<char>(taken->symbol)); }
+        state = taken->target->state;
+    }
+    return std::nullopt;
+}
+
+} // namespace.
+
+Nfa mata::nfa::generateNfa(const GeneratorParameters& parameters) {
+    if (parameters.num_of_states == 0) { throw std::invalid_argument("generateNfa: The automaton needs a state."); }
+    if (parameters.alphabet_size == 0 || parameters.first_symbol == EPSILON
+        || parameters.first_symbol + parameters.alphabet_size > 256) {
+        throw std::invalid_argument("generateNfa: Symbols must be non-epsilon bytes.");
+    }
+    Random random{ parameters.seed };
+    const bool annotated{ parameters.num_of_counters > 0 && parameters.annotation_density > 0 };
+
+    DeltaBuilder builder{};
+    builder.reserve(static_cast<size_t>(static_cast<double>(parameters.num_of_states) * parameters.out_degree));
+    struct AnnotatedTransition {
+        State source;
+        Symbol symbol;
+        State target;
+        size_t annotation_id;
+    };
+    std::vector<AnnotatedTransition> annotated_transitions{};
+    Theta theta{};
+    for (State source{ 0 }; source < parameters.num_of_states; ++source) {
+        const size_t degree{ sampleDegree(parameters, random) };
+        for (size_t i{ 0 }; i < degree; ++i) {
+            const bool epsilon{ random.chance(parameters.epsilon_density) };
+            const Symbol symbol{ epsilon ? EPSILON
+                                         : parameters.first_symbol
+                                               + static_cast<Symbol>(random.below(parameters.alphabet_size)) };
+            const State target{ random.below(parameters.num_of_states) };
+            if (annotated && random.chance(parameters.annotation_density)) {
+                const std::vector<Annotation> annotations{ randomAnnotations(parameters, epsilon, random) };
+                annotated_transitions.push_back({ source, symbol, target, theta.add(annotations) });
+            } else {
+                builder.add(source, symbol, target);
+            }
+        }
+    }
+
+    Delta delta{ builder.build(parameters.num_of_states) };
+    for (const AnnotatedTransition& transition : annotated_transitions) {
+        delta.add(transition.source, transition.symbol, transition.target, transition.annotation_id);
+    }
+    utils::SparseSet<State> final{};
+    for (State state{ 0 }; state + 1 < parameters.num_of_states; ++state) {
+        if (random.chance(parameters.final_density)) { final.insert(state); }
+    }
+    final.insert(parameters.num_of_states - 1);
+    CounterSet counters{};
+    for (size_t counter{ 0 }; counter < parameters.num_of_counters; ++counter) { counters.addCounter(0); }
+
+    Nfa nfa{ std::move(delta), { 0 }, final, counters };
+    nfa.theta = std::move(theta);
+    return nfa;
+}
+
+std::vector<std::string> mata::nfa::generateMatchingWords(const Nfa& nfa, const CorpusParameters& parameters) {
+    Random random{ parameters.seed };
+    const std::vector<size_t> distances{ distancesToFinal(nfa) };
+    const std::vector<State> initial(nfa.initial.begin(), nfa.initial.end());
+    std::vector<std::string> words{};
+    if (initial.empty()) { return words; }
+
+    const size_t max_attempts{ 4 * parameters.num_of_words + 16 };
+    for (size_t attempt{ 0 }; attempt < max_attempts && words.size() < parameters.num_of_words; ++attempt) {
+        if (std::optional<std::string> word{ randomRun(nfa, distances, initial, parameters.length, random) }) {
+            words.push_back(std::move(*word));
+        }
+    }
+    return words;
+}
+
+std::vector<std::string> mata::nfa::generateNonMatchingWords(const Nfa& nfa, const CorpusParameters& parameters) {
+    if (parameters.alphabet_size == 0 || parameters.first_symbol + parameters.alphabet_size > 256) {
+        throw std::invalid_argument("generateNonMatchingWords: Symbols must be bytes.");
+    }
+    Random random{ parameters.seed };
+    const auto random_symbol{ [&] {
+        return static_cast<char>(parameters.first_symbol + random.below(parameters.alphabet_size));
+    } };
+
+    // Near misses are derived from a few matching words.
+    CorpusParameters near_miss_parameters{ parameters };
+    near_miss_parameters.seed = parameters.seed ^ 0x5bd1e995;
+    near_miss_parameters.num_of_words = std::min<size_t>(parameters.num_of_words, 16);
+    const std::vector<std::string> matching_words{ generateMatchingWords(nfa, near_miss_parameters) };
+
+    std::vector<std::string> words{};
+    const size_t max_attempts{ 20 * parameters.num_of_words + 16 };
+    for (size_t attempt{ 0 }; attempt < max_attempts && words.size() < parameters.num_of_words; ++attempt) {
+        std::string word{};
+        if (attempt % 2 == 1 && !matching_words.empty()) {
+            word = matching_words[random.below(matching_words.size())].substr(0, parameters.length);
+            if (!word.empty() && random.chance(0.5)) { word[random.below(word.size())] = random_symbol(); }
+            while (word.size() < parameters.length) { word.push_back(random_symbol()); }
+        } else {
+            word.resize(parameters.length);
+            for (char& symbol : word) { symbol = random_symbol(); }
+        }
+        if (!accepts(nfa, word)) { words.push_back(std::move(word)); }
+    }
+    return words;
+}
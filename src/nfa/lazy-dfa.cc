@@ -0,0 +1,82 @@
+#include "../../include/mata/nfa/lazy-dfa.hh"
+
+using namespace mata::nfa;
+
+namespace {
+// Rough overhead of a node in std::unordered_map (node pointers and cached hash) and of the bucket.
+constexpr size_t MAP_NODE_OVERHEAD{ 4 * sizeof(void*) };
+} // namespace.
+
+LazyDfa::LazyDfa(const Nfa& nfa, const size_t memory_budget)
+    : nfa_{ nfa }, memory_budget_{ memory_budget },
+      current_{ nfa.numStates() }, next_{ nfa.numStates() } {}
+
+void LazyDfa::flush() {
+    ids_.clear();
+    macrostates_.clear();
+    accepting_.clear();
+    successors_.clear();
+    initial_ = UNKNOWN;
+    memory_used_ = 0;
+}
+
+LazyDfa::MacroState LazyDfa::intern(StateSet&& states) {
+    if (const auto it{ ids_.find(states) }; it != ids_.end()) {
+        return it->second;
+    }
+
+    const size_t cost{ sizeof(StateSet) + states.size() * sizeof(State) + MAP_NODE_OVERHEAD
+                       + ALPHABET_SIZE * sizeof(MacroState) + sizeof(const StateSet*) };
+    if (memory_used_ + cost > memory_budget_ && !macrostates_.empty()) {
+        flush();
+        ++stats_.flushes;
+    }
+    memory_used_ += cost;
+
+    const MacroState id{ macrostates_.size() };
+    const auto [it, inserted]{ ids_.emplace(std::move(states), id) };
+    macrostates_.push_back(&it->first);
+    accepting_.push_back(nfa_.final.intersects_with(it->first));
+    successors_.resize(successors_.size() + ALPHABET_SIZE, UNKNOWN);
+    return id;
+}
+
+LazyDfa::MacroState LazyDfa::getInitial() {
+    if (initial_ == UNKNOWN) {
+        current_.clear();
+        current_.insert(nfa_.initial.begin(), nfa_.initial.end());
+        nfa_.epsilonClosure(current_);
+        initial_ = intern(StateSet{ current_.begin(), current_.end() });
+    }
+    return initial_;
+}
+
+LazyDfa::MacroState LazyDfa::getSuccessor(const MacroState macrostate, const Symbol symbol) {
+    MacroState& cached{ successors_[macrostate * ALPHABET_SIZE + symbol] };
+    if (cached != UNKNOWN) {
+        ++stats_.hits;
+        return cached;
+    }
+    ++stats_.misses;
+
+    current_.clear();
+    current_.insert(macrostates_[macrostate]->begin(), macrostates_[macrostate]->end());
+    nfa_.post(current_, symbol, next_);
+
+    const size_t flushes{ stats_.flushes };
+    const MacroState successor{ intern(StateSet{ next_.begin(), next_.end() }) };
+    // After a flush, @p macrostate no longer exists and neither does the reference to its successor.
+    if (flushes == stats_.flushes) {
+        successors_[macrostate * ALPHABET_SIZE + symbol] = successor;
+    }
+    return successor;
+}
+
+bool LazyDfa::simulate(const std::string& input) {
+    MacroState macrostate{ getInitial() };
+    for (const char c : input) {
+        if (macrostates_[macrostate]->empty()) { return false; }
+        macrostate = getSuccessor(macrostate, toSymbol(c));
+    }
+    return accepting_[macrostate];
+}
@@ -0,0 +1,433 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "../../include/mata/nfa/delta-builder.hh"
+#include "../../include/mata/nfa/mata-format.hh"
+#include "../../include/mata/utils/mapped-file.hh"
+
+using namespace mata::nfa;
+using mata::utils::MappedFile;
+using mata::utils::SparseSet;
+
+namespace {
+
+/// States with names other than @c qN and @c N are numbered after all numbered states, which are only known at the
+///  end. Until then, they are marked by this bit and numbered by the order of their first occurrence.
+constexpr State NAMED_STATE{ State{ 1 } << (sizeof(State) * 8 - 1) };
+
+constexpr std::array<bool, 256> SPACES{ [] {
+    std::array<bool, 256> spaces{};
+    for (const char c : { ' ', '\t', '\r', '\v', '\f' }) { spaces[static_cast<unsigned char>(c)] = true; }
+    return spaces;
+}() };
+
+bool isSpace(const char c) { return SPACES[static_cast<unsigned char>(c)]; }
+
+template<class Number>
+bool parseNumber(const std::string_view token, Number& number) {
+    // Short numbers cannot overflow and are parsed by a plain loop, which is faster than std::from_chars.
+    if (token.empty() || token.size() > std::numeric_limits<Number>::digits10) {
+        const auto [end, error]{ std::from_chars(token.data(), token.data() + token.size(), number) };
+        return error == std::errc{} && end == token.data() + token.size() && !token.empty();
+    }
+    Number value{ 0 };
+    for (const char c : token) {
+        const unsigned digit{ static_cast<unsigned>(c) - '0' };
+        if (digit > 9) { return false; }
+        value = value * 10 + digit;
+    }
+    number = value;
+    return true;
+}
+
+/// Streaming parser of the text of an automaton, see @c parseMata().
+class Parser {
+public:
+    explicit Parser(const std::string_view text) : position_{ text.data() }, end_{ text.data() + text.size() } {
+        // Most lines are transitions; counting the lines is much cheaper than growing the builder repeatedly.
+        builder_.reserve(static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1);
+    }
+
+    Nfa parse() {
+        while (nextLine()) {
+            if (seen_type_ && parsePlainTransition()) { continue; }
+            if (!nextToken()) { continue; }
+            if (token_.front() == '@') { parseType(); }
+            else if (!seen_type_) { fail("the automaton does not start by @NFA-explicit"); }
+            else if (token_.front() == '%') { parseKey(); }
+            else { parseTransition(); }
+        }
+        if (!seen_type_) { fail("the automaton does not start by @NFA-explicit"); }
+        return finish();
+    }
+
+private:
+    enum class Alphabet { Numbers, Chars };
+
+    struct PendingTransition {
+        State source;
+        Symbol symbol;
+        State target;
+        size_t annotation_id;
+    };
+
+    const char* position_;
+    const char* const end_;
+    const char* line_end_{ nullptr };
+    size_t line_number_{ 0 };
+    std::string_view token_{};
+
+    bool seen_type_{ false };
+    Alphabet alphabet_{ Alphabet::Chars };
+    DeltaBuilder builder_{};
+    /// Transitions with named states or annotations, added when the named states are numbered.
+    std::vector<PendingTransition> pending_{};
+    std::vector<State> initial_{};
+    std::vector<State> final_{};
+    CounterSet counters_{};
+    Theta theta_{};
+    std::vector<Annotation> annotations_{};
+    std::unordered_map<std::string_view, State> names_{};
+    State max_state_{ 0 };
+    bool has_numbered_state_{ false };
+    size_t max_counter_id_{ 0 };
+    bool has_annotation_{ false };
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error("parseMata: Line " + std::to_string(line_number_) + ": " + message + ".");
+    }
+
+    /// Move to the next line; false at the end of the text.
+    bool nextLine() {
+        if (line_end_ != nullptr) {
+            if (line_end_ == end_) { return false; }
+            position_ = line_end_ + 1;
+        }
+        const void* const newline{
+            position_ == end_ ? nullptr : std::memchr(position_, '\n', static_cast<size_t>(end_ - position_)) };
+        line_end_ = newline == nullptr ? end_ : static_cast<const char*>(newline);
+        ++line_number_;
+        return true;
+    }
+
+    /// Read the next token of the line into @c token_; false at the end of the line or at a comment.
+    bool nextToken() {
+        while (position_ != line_end_ && isSpace(*position_)) { ++position_; }
+        if (position_ == line_end_ || *position_ == '#') {
+            position_ = line_end_;
+            return false;
+        }
+        const char* const begin{ position_ };
+        while (position_ != line_end_ && !isSpace(*position_)) { ++position_; }
+        token_ = { begin, static_cast<size_t>(position_ - begin) };
+        return true;
+    }
+
+    void expectEndOfLine() {
+        if (nextToken()) { fail("unexpected '" + std::string{ token_ } + "'"); }
+    }
+
+    void parseType() {
+        if (token_ != "@NFA-explicit") { fail("unsupported automaton type '" + std::string{ token_ } + "'"); }
+        if (seen_type_) { fail("only one automaton per input is supported"); }
+        seen_type_ = true;
+        expectEndOfLine();
+    }
+
+    void parseKey() {
+        if (token_ == "%Initial" || token_ == "%Final") {
+            std::vector<State>& states{ token_ == "%Initial" ? initial_ : final_ };
+            while (nextToken()) { states.push_back(parseState()); }
+        } else if (token_ == "%Counters") {
+            while (nextToken()) {
+                CounterValue value{};
+                if (!parseNumber(token_, value)) { fail("invalid counter value '" + std::string{ token_ } + "'"); }
+                counters_.addCounter(value);
+            }
+        } else if (token_ == "%Alphabet-numbers") {
+            alphabet_ = Alphabet::Numbers;
+            expectEndOfLine();
+        } else if (token_ == "%Alphabet-chars" || token_ == "%Alphabet-auto") {
+            alphabet_ = Alphabet::Chars;
+            expectEndOfLine();
+        } else if (token_.starts_with("%States")) {
+            position_ = line_end_;
+        } else {
+            fail("unsupported key '" + std::string{ token_ } + "'");
+        }
+    }
+
+    State parseState() {
+        std::string_view digits{ token_ };
+        if (digits.size() > 1 && digits.front() == 'q') { digits.remove_prefix(1); }
+        if (State state{}; parseNumber(digits, state)) {
+            if (state >= NAMED_STATE) { fail("state " + std::string{ token_ } + " is too large"); }
+            max_state_ = std::max(max_state_, state);
+            has_numbered_state_ = true;
+            return state;
+        }
+        return NAMED_STATE | names_.try_emplace(token_, names_.size()).first->second;
+    }
+
+    Symbol parseSymbol() {
+        Symbol symbol{};
+        if (alphabet_ == Alphabet::Numbers) {
+            if (!parseNumber(token_, symbol)) { fail("invalid symbol '" + std::string{ token_ } + "'"); }
+        } else {
+            if (token_.size() == 1) {
+                symbol = toSymbol(token_.front());
+            } else if (!(token_.size() == 4 && token_.starts_with("\\x")
+                         && std::from_chars(token_.data() + 2, token_.data() + 4, symbol, 16).ptr
+                                == token_.data() + 4)) {
+                fail("invalid symbol '" + std::string{ token_ } + "'");
+            }
+            // Both a NUL byte and \x00 would read as epsilon.
+            if (symbol == EPSILON) { fail("epsilon cannot be written with %Alphabet-chars"); }
+        }
+        return symbol;
+    }
+
+    /**
+     * Fast path of the most common lines: a transition without annotations between numbered states, separated by
+     *  single spaces (as written by @c writeMata()), parsed in a single pass over the line.
+     * @return False (without consuming anything) if the line has another form, which is then parsed by the tokens.
+     */
+    bool parsePlainTransition() {
+        const char* position{ position_ };
+        State source{}, target{};
+        Symbol symbol{};
+        if (!scanState(position, source) || position == line_end_ || *position++ != ' ') { return false; }
+        if (alphabet_ == Alphabet::Numbers) {
+            if (!scanNumber(position, symbol)) { return false; }
+        } else {
+            // A NUL byte (epsilon) is rejected by the general path.
+            if (line_end_ - position < 2 || isSpace(*position) || *position == '#' || *position == '\0') {
+                return false;
+            }
+            symbol = toSymbol(*position++);
+        }
+        if (position == line_end_ || *position++ != ' ' || !scanState(position, target)) { return false; }
+        if (position != line_end_ && !(*position == '\r' && position + 1 == line_end_)) { return false; }
+
+        max_state_ = std::max({ max_state_, source, target });
+        has_numbered_state_ = true;
+        builder_.add(source, symbol, target);
+        position_ = line_end_;
+        return true;
+    }
+
+    /// Scan a state @c qN or @c N at @p position, advancing it.
+    bool scanState(const char*& position, State& state) const {
+        if (position != line_end_ && *position == 'q') { ++position; }
+        return scanNumber(position, state) && state < NAMED_STATE;
+    }
+
+    /// Scan a decimal number at @p position, advancing it. Longer numbers are left to the general path.
+    template<class Number>
+    bool scanNumber(const char*& position, Number& number) const {
+        const char* const begin{ position };
+        Number value{ 0 };
+        for (; position != line_end_; ++position) {
+            const unsigned digit{ static_cast<unsigned>(*position) - '0' };
+            if (digit > 9) { break; }
+            value = value * 10 + digit;
+        }
+        const ptrdiff_t num_of_digits{ position - begin };
+        number = value;
+        return num_of_digits > 0 && num_of_digits <= std::numeric_limits<Number>::digits10;
+    }
+
+    void parseTransition() {
+        const State source{ parseState() };
+        if (!nextToken()) { fail("missing symbol"); }
+        const Symbol symbol{ parseSymbol() };
+        if (!nextToken()) { fail("missing target"); }
+        const State target{ parseState() };
+
+        if (!nextToken()) {
+            if (((source | target) & NAMED_STATE) == 0) { builder_.add(source, symbol, target); }
+            else { pending_.push_back({ source, symbol, target, UNDEFINED_ID }); }
+            return;
+        }
+        if (token_ != "|") { fail("unexpected '" + std::string{ token_ } + "'"); }
+        annotations_.clear();
+        while (nextToken()) { annotations_.push_back(parseAnnotation()); }
+        if (annotations_.empty()) { fail("missing annotations after '|'"); }
+        pending_.push_back({ source, symbol, target, theta_.add(annotations_) });
+    }
+
+    /// Parse an annotation written as name(arguments), e.g. in(0,2,5).
+    Annotation parseAnnotation() {
+        const size_t open{ token_.find('(') };
+        if (open == std::string_view::npos || token_.back() != ')') {
+            fail("invalid annotation '" + std::string{ token_ } + "'");
+        }
+        const std::string_view name{ token_.substr(0, open) };
+        std::string_view arguments{ token_.substr(open + 1, token_.size() - open - 2) };
+        CounterValue values[3]{};
+        size_t num_of_values{ 0 };
+        while (true) {
+            const size_t comma{ arguments.find(',') };
+            if (num_of_values == 3 || !parseNumber(arguments.substr(0, comma), values[num_of_values])) {
+                fail("invalid arguments of '" + std::string{ token_ } + "'");
+            }
+            ++num_of_values;
+            if (comma == std::string_view::npos) { break; }
+            arguments.remove_prefix(comma + 1);
+        }
+
+        const size_t counter{ values[0] };
+        const auto expect{ [&](const size_t num_of_arguments) {
+            if (num_of_values != num_of_arguments) {
+                fail("'" + std::string{ name } + "' takes " + std::to_string(num_of_arguments) + " arguments");
+            }
+        } };
+        if (counter > std::numeric_limits<uint32_t>::max()) {
+            fail("counter " + std::to_string(counter) + " is too large");
+        }
+        max_counter_id_ = std::max(max_counter_id_, counter);
+        has_annotation_ = true;
+        if (name == "inc") { expect(2); return Annotation::increment(counter, values[1]); }
+        if (name == "dec") { expect(2); return Annotation::decrement(counter, values[1]); }
+        if (name == "reset") { expect(1); return Annotation::reset(counter); }
+        if (name == "eq") { expect(2); return Annotation::testEqual(counter, values[1]); }
+        if (name == "lt") { expect(2); return Annotation::testLess(counter, values[1]); }
+        if (name == "ge") { expect(2); return Annotation::testGreaterEqual(counter, values[1]); }
+        if (name == "in") { expect(3); return Annotation::testInRange(counter, values[1], values[2]); }
+        fail("unknown annotation '" + std::string{ name } + "'");
+    }
+
+    Nfa finish() {
+        if (has_annotation_ && max_counter_id_ >= counters_.size()) {
+            fail("counter " + std::to_string(max_counter_id_) + " is not declared by %Counters");
+        }
+        // Named states follow the numbered ones.
+        const State first_named{ has_numbered_state_ ? max_state_ + 1 : 0 };
+        const auto resolve{ [&](const State state) {
+            return (state & NAMED_STATE) == 0 ? state : first_named + (state & ~NAMED_STATE);
+        } };
+        const size_t num_of_states{ first_named + names_.size() };
+
+        for (const PendingTransition& transition : pending_) {
+            if (transition.annotation_id == UNDEFINED_ID) {
+                builder_.add(resolve(transition.source), transition.symbol, resolve(transition.target));
+            }
+        }
+        Delta delta{ builder_.build(num_of_states) };
+        for (const PendingTransition& transition : pending_) {
+            if (transition.annotation_id != UNDEFINED_ID) {
+                delta.add(resolve(transition.source), transition.symbol, resolve(transition.target),
+                          transition.annotation_id);
+            }
+        }
+
+        SparseSet<State> initial(num_of_states);
+        for (const State state : initial_) { initial.insert(resolve(state)); }
+        SparseSet<State> final(num_of_states);
+        for (const State state : final_) { final.insert(resolve(state)); }
+        Nfa nfa{ std::move(delta), initial, final, counters_ };
+        nfa.theta = std::move(theta_);
+        return nfa;
+    }
+};
+
+/// Output buffered in a string, numbers are formatted by std::to_chars.
+class Writer {
+public:
+    explicit Writer(std::ostream& output) : output_{ output } { buffer_.reserve(CAPACITY); }
+    ~Writer() { flush(); }
+
+    Writer& operator<<(const std::string_view text) {
+        buffer_.append(text);
+        if (buffer_.size() >= CAPACITY) { flush(); }
+        return *this;
+    }
+    Writer& operator<<(const char c) {
+        buffer_.push_back(c);
+        return *this;
+    }
+    template<std::unsigned_integral Number>
+    Writer& operator<<(const Number number) {
+        char digits[std::numeric_limits<Number>::digits10 + 1];
+        return *this << std::string_view{ digits, std::to_chars(std::begin(digits), std::end(digits), number).ptr };
+    }
+
+    void flush() {
+        output_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+
+private:
+    static constexpr size_t CAPACITY{ 1 << 16 };
+    std::ostream& output_;
+    std::string buffer_{};
+};
+
+void writeAnnotation(const Annotation& annotation, Writer& writer) {
+    const auto write{ [&](const std::string_view name, const bool operand) {
+        writer << name << '(' << annotation.counter_id;
+        if (operand) { writer << ',' << annotation.operand; }
+    } };
+    switch (annotation.opcode) {
+        case Annotation::Opcode::Increment: write("inc", true); break;
+        case Annotation::Opcode::Decrement: write("dec", true); break;
+        case Annotation::Opcode::Reset: write("reset", false); break;
+        case Annotation::Opcode::TestEqual: write("eq", true); break;
+        case Annotation::Opcode::TestLess: write("lt", true); break;
+        case Annotation::Opcode::TestGreaterEqual: write("ge", true); break;
+        case Annotation::Opcode::TestInRange: write("in", true); writer << ',' << annotation.upper; break;
+    }
+    writer << ')';
+}
+
+void writeStates(const std::string_view key, const SparseSet<State>& states, Writer& writer) {
+    std::vector<State> sorted(states.begin(), states.end());
+    std::sort(sorted.begin(), sorted.end());
+    writer << key;
+    for (const State state : sorted) { writer << " q" << state; }
+    writer << '\n';
+}
+
+} // namespace.
+
+Nfa mata::nfa::parseMata(const std::string_view text) { return Parser{ text }.parse(); }
+
+Nfa mata::nfa::loadMata(const std::string& path) {
+    const MappedFile file{ path };
+    file.adviseSequential();
+    return parseMata(file.text());
+}
+
+void mata::nfa::writeMata(const Nfa& nfa, std::ostream& output) {
+    Writer writer{ output };
+    writer << "@NFA-explicit\n%Alphabet-numbers\n";
+    writeStates("%Initial", nfa.initial, writer);
+    writeStates("%Final", nfa.final, writer);
+    if (nfa.counters.size() > 0) {
+        writer << "%Counters";
+        for (size_t counter{ 0 }; counter < nfa.counters.size(); ++counter) {
+            writer << ' ' << nfa.counters[counter].initial_value;
+        }
+        writer << '\n';
+    }
+    for (State source{ 0 }; source < nfa.delta.numStates(); ++source) {
+        for (const SymbolPost& symbol_post : nfa.delta.getStatePost(source)) {
+            for (const Target& target : symbol_post.targets) {
+                writer << 'q' << source << ' ' << symbol_post.symbol << " q" << target.state;
+                if (target.annotation_id != UNDEFINED_ID) {
+                    writer << " |";
+                    for (const Annotation& annotation : nfa.theta[target.annotation_id]) {
+                        writer << ' ';
+                        writeAnnotation(annotation, writer);
+                    }
+                }
+                writer << '\n';
+            }
+        }
+    }
+}
@@ -1,6 +1,8 @@
 #include "../../include/mata/nfa/nfa.hh"
 
 using namespace mata::nfa;
+using mata::utils::SparseSet;
+namespace stats = mata::utils::stats;
 
 void Nfa::addInitialState(State state) {
     initial.insert(state);
@@ -10,38 +12,152 @@ void Nfa::addFinalState(State state) {
     final.insert(state);
 }
 
-// Simulate the NFA
-bool Nfa::simulate(const std::string& input) const {
-    for (State state : initial) {
-        if ( simulateRecursive(state, input, 0) ) {
-            return true;
+size_t Nfa::numStates() const {
+    return std::max({ delta.numStates(), initial.domain_size(), final.domain_size() });
+}
+
+namespace {
+
+template<class DeltaType>
+void epsilonClosure(const DeltaType& delta, SparseSet<State>& states) {
+    // Closures are transitive, so only the states present at the start need to be expanded.
+    for (size_t i{ 0 }, size{ states.size() }; i < size; ++i) {
+        const State state{ states.begin()[static_cast<long>(i)] };
+        if (state >= delta.numStates()) { continue; }
+        for (const State reachable : delta.getEpsilonClosure(state)) {
+            states.insert(reachable);
         }
     }
-    return false;
 }
 
-// Recursive helper function to simulate the NFA
-bool Nfa::simulateRecursive(State currentState, const std::string& input, size_t index) const {
-    if ( index == input.size() ) {
-        // Note: If we reach the end of the input, check if the current state is accepting.
-        return final.contains(currentState);
+void epsilonClosure(const Delta& delta, SparseSet<State>& states) { delta.epsilonClosure(states); }
+
+template<class DeltaType>
+void post(const DeltaType& delta, const SparseSet<State>& states, const Symbol symbol, SparseSet<State>& result) {
+    // Without a closure index (a Delta not frozen yet), the targets are collected first and closed at once.
+    const bool closures_indexed{ delta.hasEpsilonClosures() };
+    result.clear();
+    // A NUL byte of the input is the symbol EPSILON, which matches no transition: epsilon transitions consume nothing.
+    if (symbol == EPSILON) { return; }
+    for (const State state : states) {
+        if (state >= delta.numStates()) { continue; }
+
+        const auto state_post{ delta.getStatePost(state) };
+        const auto symbol_post{ state_post.find(symbol) };
+        if (symbol_post == state_post.end()) { continue; }
+        // Note: FrozenDelta returns the symbol post by value; binding the member extends the lifetime of the view.
+        const auto& targets{ (*symbol_post).targets };
+        stats::add(&stats::Stats::transitions_examined, targets.size());
+        for (const State target : targets) {
+            if (!closures_indexed) {
+                result.insert(target);
+                continue;
+            }
+            for (const State reachable : delta.getEpsilonClosure(target)) {
+                result.insert(reachable);
+            }
+        }
+    }
+    if (!closures_indexed) { epsilonClosure(delta, result); }
+}
+
+template<class DeltaType>
+bool simulate(const DeltaType& delta, const size_t num_of_states, const std::span<const State> initial,
+              const std::span<const State> final, const std::string& input) {
+    stats::start_simulation();
+    SparseSet<State> current(num_of_states);
+    SparseSet<State> next(num_of_states);
+
+    current.insert(initial.begin(), initial.end());
+    epsilonClosure(delta, current);
+    stats::active_states(current.size());
+
+    for (const char c : input) {
+        if (current.empty()) { return false; }
+        post(delta, current, toSymbol(c), next);
+        std::swap(current, next);
+        stats::active_states(current.size());
     }
 
-    Symbol symbol = static_cast<Symbol>( input[index] );
+    return std::any_of(final.begin(), final.end(), [&](const State state) { return current.contains(state); });
+}
+
+/// States of @p states as a span (the elements of a SparseSet are contiguous).
+std::span<const State> statesOf(const SparseSet<State>& states) { return { states.begin(), states.end() }; }
 
-    // Get the transitions for the current state
-    const auto& statePost = delta.getStatePost(currentState);
+} // namespace.
 
-    // Iterate through the transitions
-    for (const auto& transition : statePost) {
-        if (transition.symbol == symbol || transition.symbol == 0) { // 0 for epsilon transitions. TODO: Add EPSILON.
-            for (State target : transition.targets) {
-                if ( simulateRecursive(target, input, (transition.symbol == 0) ? index : index + 1) ) {
-                    return true;
-                }
+void Nfa::epsilonClosure(SparseSet<State>& states) const {
+    if (frozen_delta_) { ::epsilonClosure(*frozen_delta_, states); }
+    else { ::epsilonClosure(delta, states); }
+}
+
+void Nfa::post(const SparseSet<State>& states, const Symbol symbol, SparseSet<State>& result) const {
+    if (frozen_delta_) { ::post(*frozen_delta_, states, symbol, result); }
+    else { ::post(delta, states, symbol, result); }
+}
+
+BitParallelDeltaVariant mata::nfa::makeBitParallelDelta(const FrozenDelta& delta, const size_t num_of_states) {
+    if (num_of_states <= BitParallelDelta<1>::MAX_NUM_OF_STATES) { return BitParallelDelta<1>{ delta }; }
+    if (num_of_states <= BitParallelDelta<2>::MAX_NUM_OF_STATES) { return BitParallelDelta<2>{ delta }; }
+    if (num_of_states <= BitParallelDelta<4>::MAX_NUM_OF_STATES) { return BitParallelDelta<4>{ delta }; }
+    return std::monostate{};
+}
+
+bool mata::nfa::simulateFrozen(const FrozenDelta& delta, const BitParallelDeltaVariant& bit_parallel_delta,
+                               const size_t num_of_states, const std::span<const State> initial,
+                               const std::span<const State> final, const std::string& input) {
+    std::optional<bool> accepted{};
+    std::visit([&](const auto& bit_parallel) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(bit_parallel)>, std::monostate>) {
+            // States added after freezing may not fit into the bit vectors.
+            if (num_of_states <= bit_parallel.MAX_NUM_OF_STATES) {
+                stats::start_simulation();
+                accepted = bit_parallel.simulate(initial, final, input);
             }
         }
+    }, bit_parallel_delta);
+    if (accepted) { return *accepted; }
+    return ::simulate(delta, num_of_states, initial, final, input);
+}
+
+// Simulate the NFA
+bool Nfa::simulate(const std::string& input) const {
+    if (!frozen_delta_) { return ::simulate(delta, numStates(), statesOf(initial), statesOf(final), input); }
+    return simulateFrozen(*frozen_delta_, bit_parallel_delta_, numStates(), statesOf(initial), statesOf(final), input);
+}
+
+void Nfa::freeze(const bool bit_parallel) {
+    delta.computeEpsilonClosures();
+    frozen_delta_.emplace(delta);
+
+    if (bit_parallel) {
+        bit_parallel_delta_ = makeBitParallelDelta(*frozen_delta_, numStates());
+    } else {
+        bit_parallel_delta_ = std::monostate{};
     }
+}
+
+NfaMemoryUsage Nfa::memoryUsage() const {
+    NfaMemoryUsage usage{};
+    usage.delta = delta.memoryUsage();
+    usage.initial = initial.memory_usage();
+    usage.final = final.memory_usage();
+    usage.counters = counters.memoryUsage();
+    usage.theta = theta.memoryUsage();
+    if (frozen_delta_) { usage.frozen_delta = frozen_delta_->memoryUsage(); }
+    std::visit([&](const auto& bit_parallel_delta) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(bit_parallel_delta)>, std::monostate>) {
+            usage.frozen_delta += bit_parallel_delta.memoryUsage();
+        }
+    }, bit_parallel_delta_);
+    return usage;
+}
 
-    return false;
+void Nfa::shrinkToFit() {
+    delta.shrinkToFit();
+    initial.shrink_to_fit();
+    final.shrink_to_fit();
+    counters.shrinkToFit();
+    theta.shrinkToFit();
 }
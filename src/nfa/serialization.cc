@@ -0,0 +1,294 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "../../include/mata/nfa/serialization.hh"
+#include "../../include/mata/utils/mapped-file.hh"
+
+using namespace mata::nfa;
+using mata::utils::MappedFile;
+using mata::utils::SparseSet;
+
+namespace {
+
+constexpr std::array<char, 8> MAGIC{ 'M', 'A', 'T', 'A', 'N', 'F', 'A', '\0' };
+constexpr uint32_t BYTE_ORDER_MARK{ 0x01020304 };
+/// Sizes of the stored types, one byte each; files written with other sizes cannot be used in place.
+constexpr uint32_t TYPE_LAYOUT{ (sizeof(State) << 24) | (sizeof(Symbol) << 16) | (sizeof(CounterValue) << 8)
+                                | sizeof(Annotation) };
+static_assert(sizeof(size_t) == sizeof(State), "offsets and states are stored in the same width");
+
+enum Section : uint32_t {
+    STATE_OFFSETS,
+    SYMBOLS,
+    TARGET_OFFSETS,
+    TARGETS,
+    TARGET_ANNOTATION_IDS,
+    EPSILON_CLOSURE_OFFSETS,
+    EPSILON_CLOSURE_STATES,
+    DENSE_TABLE_OF_STATE,
+    DENSE_SLOTS,
+    INITIAL,
+    FINAL,
+    COUNTERS,
+    ANNOTATION_OFFSETS,
+    ANNOTATIONS,
+    NUM_OF_SECTIONS,
+};
+
+struct SectionEntry {
+    uint64_t offset; ///< Offset of the section from the start of the file.
+    uint64_t size; ///< Size of the section in bytes.
+};
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t type_layout;
+    uint32_t num_of_sections;
+    uint64_t file_size;
+    std::array<SectionEntry, NUM_OF_SECTIONS> sections;
+};
+
+size_t alignUp(const size_t offset) { return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT; }
+
+template<class T>
+std::span<const std::byte> bytesOf(const std::span<const T> values) { return std::as_bytes(values); }
+
+std::vector<State> sortedStates(const SparseSet<State>& states) {
+    std::vector<State> sorted(states.begin(), states.end());
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+
+std::runtime_error invalidFile(const std::string& path, const std::string& reason) {
+    return std::runtime_error("MappedNfa: " + path + " is not a valid automaton: " + reason + ".");
+}
+
+/// View the section @p id of the mapped file @p mapping as an array of @p T.
+template<class T>
+std::span<const T> viewSection(const MappedFile& mapping, const FileHeader& header, const Section id,
+                               const std::string& path) {
+    const SectionEntry& entry{ header.sections[id] };
+    if (entry.offset % SECTION_ALIGNMENT != 0 || entry.offset > mapping.size()
+        || entry.size > mapping.size() - entry.offset || entry.size % sizeof(T) != 0) {
+        throw invalidFile(path, "section " + std::to_string(id) + " is out of bounds");
+    }
+    return { reinterpret_cast<const T*>(mapping.data() + entry.offset), entry.size / sizeof(T) };
+}
+
+/// Whether @p offsets are the offsets of consecutive ranges covering an array of @p size elements.
+bool areOffsets(const std::span<const size_t> offsets, const size_t size) {
+    return !offsets.empty() && offsets.front() == 0 && offsets.back() == size
+           && std::is_sorted(offsets.begin(), offsets.end());
+}
+
+/// Whether all @p values are smaller than @p bound.
+template<class T>
+bool allBelow(const std::span<const T> values, const size_t bound) {
+    return std::all_of(values.begin(), values.end(), [&](const T value) { return static_cast<size_t>(value) < bound; });
+}
+
+} // namespace.
+
+void mata::nfa::saveNfa(const Nfa& nfa, const std::string& path) {
+    const FrozenDelta frozen_delta{ nfa.delta };
+    const FrozenDelta::Arrays& arrays{ frozen_delta.arrays() };
+
+    std::vector<size_t> target_annotation_ids{};
+    target_annotation_ids.reserve(arrays.targets.size());
+    for (State state{ 0 }; state < nfa.delta.numStates(); ++state) {
+        for (const SymbolPost& symbol_post : nfa.delta.getStatePost(state)) {
+            for (const Target& target : symbol_post.targets) { target_annotation_ids.push_back(target.annotation_id); }
+        }
+    }
+    const std::vector<State> initial{ sortedStates(nfa.initial) };
+    const std::vector<State> final{ sortedStates(nfa.final) };
+    std::vector<CounterValue> counters(nfa.counters.size());
+    for (size_t counter{ 0 }; counter < counters.size(); ++counter) {
+        counters[counter] = nfa.counters[counter].initial_value;
+    }
+    std::vector<size_t> annotation_offsets{ 0 };
+    // Padding of the records is zeroed, so equal automata give equal files.
+    std::vector<Annotation> annotations(nfa.theta.numAnnotations());
+    if (!annotations.empty()) {
+        std::memset(static_cast<void*>(annotations.data()), 0, annotations.size() * sizeof(Annotation));
+    }
+    for (size_t annotation_id{ 0 }; annotation_id < nfa.theta.size(); ++annotation_id) {
+        size_t index{ annotation_offsets.back() };
+        for (const Annotation& annotation : nfa.theta[annotation_id]) {
+            annotations[index].opcode = annotation.opcode;
+            annotations[index].counter_id = annotation.counter_id;
+            annotations[index].operand = annotation.operand;
+            annotations[index].upper = annotation.upper;
+            ++index;
+        }
+        annotation_offsets.push_back(index);
+    }
+
+    std::array<std::span<const std::byte>, NUM_OF_SECTIONS> sections{};
+    sections[STATE_OFFSETS] = bytesOf(arrays.state_offsets);
+    sections[SYMBOLS] = bytesOf(arrays.symbols);
+    sections[TARGET_OFFSETS] = bytesOf(arrays.target_offsets);
+    sections[TARGETS] = bytesOf(arrays.targets);
+    sections[TARGET_ANNOTATION_IDS] = bytesOf(std::span<const size_t>{ target_annotation_ids });
+    sections[EPSILON_CLOSURE_OFFSETS] = bytesOf(arrays.epsilon_closure_offsets);
+    sections[EPSILON_CLOSURE_STATES] = bytesOf(arrays.epsilon_closure_states);
+    sections[DENSE_TABLE_OF_STATE] = bytesOf(arrays.dense_table_of_state);
+    sections[DENSE_SLOTS] = bytesOf(arrays.dense_slots);
+    sections[INITIAL] = bytesOf(std::span<const State>{ initial });
+    sections[FINAL] = bytesOf(std::span<const State>{ final });
+    sections[COUNTERS] = bytesOf(std::span<const CounterValue>{ counters });
+    sections[ANNOTATION_OFFSETS] = bytesOf(std::span<const size_t>{ annotation_offsets });
+    sections[ANNOTATIONS] = bytesOf(std::span<const Annotation>{ annotations });
+
+    FileHeader header{};
+    header.magic = MAGIC;
+    header.version = NFA_FORMAT_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.type_layout = TYPE_LAYOUT;
+    header.num_of_sections = NUM_OF_SECTIONS;
+    size_t offset{ alignUp(sizeof(FileHeader)) };
+    for (size_t section{ 0 }; section < NUM_OF_SECTIONS; ++section) {
+        header.sections[section] = { offset, sections[section].size() };
+        offset = alignUp(offset + sections[section].size());
+    }
+    header.file_size = offset;
+
+    std::ofstream output{ path, std::ios::binary | std::ios::trunc };
+    constexpr std::array<char, SECTION_ALIGNMENT> PADDING{};
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    size_t position{ sizeof(header) };
+    for (size_t section{ 0 }; section < NUM_OF_SECTIONS; ++section) {
+        output.write(PADDING.data(), static_cast<std::streamsize>(header.sections[section].offset - position));
+        output.write(reinterpret_cast<const char*>(sections[section].data()),
+                     static_cast<std::streamsize>(sections[section].size()));
+        position = header.sections[section].offset + sections[section].size();
+    }
+    output.write(PADDING.data(), static_cast<std::streamsize>(header.file_size - position));
+    if (!output) { throw std::runtime_error("saveNfa: Cannot write " + path + "."); }
+}
+
+MappedNfa::MappedNfa(const std::string& path) {
+    const std::shared_ptr<const MappedFile> mapping{ std::make_shared<const MappedFile>(path) };
+    mapping_ = mapping;
+    const auto invalid{ [&](const std::string& reason) { return invalidFile(path, reason); } };
+
+    FileHeader header{};
+    if (mapping->size() < sizeof(header)) { throw invalid("the header is truncated"); }
+    std::memcpy(&header, mapping->data(), sizeof(header));
+    if (header.magic != MAGIC) { throw invalid("wrong magic"); }
+    if (header.version != NFA_FORMAT_VERSION) {
+        throw invalid("format version " + std::to_string(header.version) + " instead of "
+                      + std::to_string(NFA_FORMAT_VERSION));
+    }
+    if (header.byte_order != BYTE_ORDER_MARK || header.type_layout != TYPE_LAYOUT) {
+        throw invalid("written with a different byte order or type sizes");
+    }
+    if (header.num_of_sections != NUM_OF_SECTIONS || header.file_size != mapping->size()) {
+        throw invalid("wrong size");
+    }
+
+    FrozenDelta::Arrays arrays{};
+    arrays.state_offsets = viewSection<size_t>(*mapping, header, STATE_OFFSETS, path);
+    arrays.symbols = viewSection<Symbol>(*mapping, header, SYMBOLS, path);
+    arrays.target_offsets = viewSection<size_t>(*mapping, header, TARGET_OFFSETS, path);
+    arrays.targets = viewSection<State>(*mapping, header, TARGETS, path);
+    arrays.epsilon_closure_offsets = viewSection<size_t>(*mapping, header, EPSILON_CLOSURE_OFFSETS, path);
+    arrays.epsilon_closure_states = viewSection<State>(*mapping, header, EPSILON_CLOSURE_STATES, path);
+    arrays.dense_table_of_state = viewSection<uint32_t>(*mapping, header, DENSE_TABLE_OF_STATE, path);
+    arrays.dense_slots = viewSection<uint16_t>(*mapping, header, DENSE_SLOTS, path);
+    target_annotation_ids_ = viewSection<size_t>(*mapping, header, TARGET_ANNOTATION_IDS, path);
+    initial_ = viewSection<State>(*mapping, header, INITIAL, path);
+    final_ = viewSection<State>(*mapping, header, FINAL, path);
+    counters_ = viewSection<CounterValue>(*mapping, header, COUNTERS, path);
+    annotation_offsets_ = viewSection<size_t>(*mapping, header, ANNOTATION_OFFSETS, path);
+    annotations_ = viewSection<Annotation>(*mapping, header, ANNOTATIONS, path);
+
+    // The sizes of the arrays must fit together.
+    const size_t num_of_states{ arrays.dense_table_of_state.size() };
+    if (arrays.state_offsets.size() != num_of_states + 1 || arrays.target_offsets.size() != arrays.symbols.size() + 1
+        || target_annotation_ids_.size() != arrays.targets.size()
+        || arrays.epsilon_closure_offsets.size() != num_of_states + 1
+        || arrays.dense_slots.size() % FrozenDelta::BYTE_ALPHABET_SIZE != 0) {
+        throw invalid("the sizes of the sections do not match");
+    }
+    // Every position read by the simulation must stay within the arrays.
+    if (!areOffsets(arrays.state_offsets, arrays.symbols.size())
+        || !areOffsets(arrays.target_offsets, arrays.targets.size())
+        || !areOffsets(arrays.epsilon_closure_offsets, arrays.epsilon_closure_states.size())
+        || !areOffsets(annotation_offsets_, annotations_.size())) {
+        throw invalid("the offsets are out of bounds");
+    }
+    if (!allBelow(arrays.targets, num_of_states) || !allBelow(arrays.epsilon_closure_states, num_of_states)) {
+        throw invalid("a target state is out of bounds");
+    }
+    if (!std::is_sorted(initial_.begin(), initial_.end()) || !std::is_sorted(final_.begin(), final_.end())) {
+        throw invalid("the initial or final states are not sorted");
+    }
+    const size_t num_of_dense_tables{ arrays.dense_slots.size() / FrozenDelta::BYTE_ALPHABET_SIZE };
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        const uint32_t table{ arrays.dense_table_of_state[state] };
+        if (table == FrozenDelta::NO_DENSE_TABLE) { continue; }
+        if (table >= num_of_dense_tables) { throw invalid("a dense table is out of bounds"); }
+        const size_t num_of_symbol_posts{ arrays.state_offsets[state + 1] - arrays.state_offsets[state] };
+        const auto slots{ arrays.dense_slots.subspan(static_cast<size_t>(table) * FrozenDelta::BYTE_ALPHABET_SIZE,
+                                                     FrozenDelta::BYTE_ALPHABET_SIZE) };
+        if (!std::all_of(slots.begin(), slots.end(), [&](const uint16_t slot) {
+                return slot == FrozenDelta::NO_DENSE_SLOT || slot < num_of_symbol_posts;
+            })) {
+            throw invalid("a dense slot is out of bounds");
+        }
+    }
+    const size_t num_of_annotation_groups{ annotation_offsets_.size() - 1 };
+    if (!std::all_of(target_annotation_ids_.begin(), target_annotation_ids_.end(), [&](const size_t annotation_id) {
+            return annotation_id == UNDEFINED_ID || annotation_id < num_of_annotation_groups;
+        })) {
+        throw invalid("an annotation ID is out of bounds");
+    }
+    if (!std::all_of(annotations_.begin(), annotations_.end(), [&](const Annotation& annotation) {
+            return annotation.counter_id < counters_.size()
+                   && annotation.opcode <= Annotation::Opcode::TestInRange;
+        })) {
+        throw invalid("an annotation is not valid");
+    }
+
+    delta_ = FrozenDelta{ arrays, mapping };
+    bit_parallel_delta_ = makeBitParallelDelta(delta_, numStates());
+}
+
+size_t MappedNfa::numStates() const {
+    return std::max({ delta_.numStates(), initial_.empty() ? 0 : initial_.back() + 1,
+                      final_.empty() ? 0 : final_.back() + 1 });
+}
+
+Nfa MappedNfa::toNfa() const {
+    const FrozenDelta::Arrays& arrays{ delta_.arrays() };
+    Delta delta{ delta_.numStates() };
+    for (State source{ 0 }; source < delta_.numStates(); ++source) {
+        for (size_t symbol_post{ arrays.state_offsets[source] }; symbol_post < arrays.state_offsets[source + 1];
+             ++symbol_post) {
+            for (size_t target{ arrays.target_offsets[symbol_post] }; target < arrays.target_offsets[symbol_post + 1];
+                 ++target) {
+                if (target_annotation_ids_[target] == UNDEFINED_ID) {
+                    delta.add(source, arrays.symbols[symbol_post], arrays.targets[target]);
+                } else {
+                    delta.add(source, arrays.symbols[symbol_post], arrays.targets[target],
+                              target_annotation_ids_[target]);
+                }
+            }
+        }
+    }
+    CounterSet counters{};
+    for (const CounterValue value : counters_) { counters.addCounter(value); }
+
+    Nfa nfa{ std::move(delta), SparseSet<State>{ initial_.begin(), initial_.end() },
+            SparseSet<State>{ final_.begin(), final_.end() }, counters };
+    for (size_t annotation_id{ 0 }; annotation_id < numAnnotationGroups(); ++annotation_id) {
+        nfa.theta.add(annotations(annotation_id));
+    }
+    return nfa;
+}
@@ -0,0 +1,115 @@
+#include "../../include/mata/nfa/theta.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+constexpr CounterValue MAX_VALUE{ std::numeric_limits<CounterValue>::max() };
+
+/// Net shift of a counter by annotations, within [-MAX_VALUE, MAX_VALUE]: no value can be shifted further by exact
+///  arithmetic.
+struct Shift {
+    CounterValue amount{ 0 };
+    bool negative{ false };
+
+    /// Add @p operand to the shift, or subtract it if @p subtract. @return False if the shift leaves the range.
+    bool add(const CounterValue operand, const bool subtract) {
+        if (negative == subtract || amount == 0) {
+            if (operand > MAX_VALUE - amount) { return false; }
+            amount += operand;
+            negative = subtract;
+        } else if (operand <= amount) {
+            amount -= operand;
+        } else {
+            amount = operand - amount;
+            negative = subtract;
+        }
+        negative = negative && amount != 0;
+        return true;
+    }
+};
+
+void make_unsatisfiable(Guard& guard) {
+    guard.low = 1;
+    guard.high = 0;
+}
+
+/// Restrict @p guard to the values v such that v + @p shift lies in [@p low, @p high].
+void restrict(Guard& guard, const Shift shift, const CounterValue low, const CounterValue high) {
+    const CounterValue amount{ shift.amount };
+    CounterValue shifted_low, shifted_high;
+    if (!shift.negative) {
+        if (high < amount) { make_unsatisfiable(guard); return; }
+        shifted_low = low > amount ? low - amount : 0;
+        shifted_high = high - amount;
+    } else {
+        if (low > MAX_VALUE - amount) { make_unsatisfiable(guard); return; }
+        shifted_low = low + amount;
+        shifted_high = high > MAX_VALUE - amount ? MAX_VALUE : high + amount;
+    }
+    guard.low = std::max(guard.low, shifted_low);
+    guard.high = std::min(guard.high, shifted_high);
+}
+
+} // namespace.
+
+size_t Theta::add(const std::span<const Annotation> annotations) {
+    annotations_.insert(annotations_.end(), annotations.begin(), annotations.end());
+    offsets_.push_back(annotations_.size());
+
+    // Net shift of the counters by the annotations seen so far; tests of a counter after its reset stay actions.
+    struct CounterShift {
+        uint32_t counter_id;
+        Shift shift;
+        bool reset;
+    };
+    std::vector<CounterShift> shifts{};
+    const auto shift_of{ [&](const uint32_t counter_id) -> CounterShift& {
+        for (CounterShift& shift : shifts) { if (shift.counter_id == counter_id) { return shift; } }
+        return shifts.emplace_back(CounterShift{ counter_id, {}, false });
+    } };
+    const size_t first_guard{ guards_.size() };
+    const auto guard_of{ [&](const uint32_t counter_id) -> Guard& {
+        for (size_t i{ first_guard }; i < guards_.size(); ++i) {
+            if (guards_[i].counter_id == counter_id) { return guards_[i]; }
+        }
+        return guards_.emplace_back(Guard{ counter_id, 0, std::numeric_limits<CounterValue>::max() });
+    } };
+
+    for (const Annotation& annotation : annotations) {
+        CounterShift& shift{ shift_of(annotation.counter_id) };
+        if (shift.reset) {
+            actions_.push_back(annotation);
+            continue;
+        }
+        switch (annotation.opcode) {
+            case Annotation::Opcode::Increment:
+                // No value can be shifted out of the range of values (the guard then stays empty).
+                if (!shift.shift.add(annotation.operand, false)) {
+                    make_unsatisfiable(guard_of(annotation.counter_id));
+                }
+                actions_.push_back(annotation);
+                break;
+            case Annotation::Opcode::Decrement:
+                restrict(guard_of(annotation.counter_id), shift.shift, annotation.operand, MAX_VALUE);
+                if (!shift.shift.add(annotation.operand, true)) { make_unsatisfiable(guard_of(annotation.counter_id)); }
+                actions_.push_back(annotation);
+                break;
+            case Annotation::Opcode::Reset:
+                shift.reset = true;
+                actions_.push_back(annotation);
+                break;
+            case Annotation::Opcode::TestEqual:
+            case Annotation::Opcode::TestLess:
+            case Annotation::Opcode::TestGreaterEqual:
+            case Annotation::Opcode::TestInRange: {
+                const auto [low, high]{ annotation.testedRange() };
+                restrict(guard_of(annotation.counter_id), shift.shift, low, high);
+                break;
+            }
+        }
+    }
+    guard_offsets_.push_back(guards_.size());
+    action_offsets_.push_back(actions_.size());
+    return size() - 1;
+}
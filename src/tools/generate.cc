@@ -0,0 +1,132 @@
+// Command line generator of random automata and input corpora, see usage().
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#include "../../include/mata/nfa/generator.hh"
+#include "../../include/mata/nfa/mata-format.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "Writes a random automaton (to --output or the standard output) and input corpora.\n"
+              << "  --seed N             seed of the automaton and the corpora (0)\n"
+              << "  --states N           number of states (100)\n"
+              << "  --alphabet N         number of symbols, starting at 'a' (4)\n"
+              << "  --degree X           mean out-degree of states (2)\n"
+              << "  --distribution D     out-degree distribution: constant, uniform, geometric, power-law (uniform)\n"
+              << "  --epsilon X          probability of epsilon transitions (0)\n"
+              << "  --finals X           probability of final states (0.1)\n"
+              << "  --counters N         number of counters (0)\n"
+              << "  --annotations X      probability of annotated transitions (0)\n"
+              << "  --bound N            largest constant counters are compared with (10)\n"
+              << "  --decrements 0|1     whether annotations may decrement counters (0)\n"
+              << "  --output FILE        file to write the automaton to\n"
+              << "  --words N            number of words of each corpus (100)\n"
+              << "  --length N           length of the words (1000)\n"
+              << "  --matching FILE      file to write accepted words to, one per line\n"
+              << "  --non-matching FILE  file to write rejected words to, one per line\n";
+}
+
+bool writeWords(const std::vector<std::string>& words, const std::string& path) {
+    std::ofstream output{ path };
+    for (const std::string& word : words) { output << word << "\n"; }
+    return static_cast<bool>(output);
+}
+
+} // namespace.
+
+int main(int argc, char* argv[]) {
+    GeneratorParameters parameters{};
+    CorpusParameters corpus{};
+    std::string output_path{}, matching_path{}, non_matching_path{};
+    const std::map<std::string, DegreeDistribution> distributions{
+        { "constant", DegreeDistribution::Constant }, { "uniform", DegreeDistribution::Uniform },
+        { "geometric", DegreeDistribution::Geometric }, { "power-law", DegreeDistribution::PowerLaw },
+    };
+
+    for (int i{ 1 }; i < argc; ++i) {
+        const std::string option{ argv[i] };
+        if (option == "--help" || i + 1 == argc) {
+            usage(argv[0]);
+            return option == "--help" ? 0 : 1;
+        }
+        const char* const value{ argv[++i] };
+        if (option == "--seed") { parameters.seed = std::strtoull(value, nullptr, 10); }
+        else if (option == "--states") { parameters.num_of_states = std::strtoull(value, nullptr, 10); }
+        else if (option == "--alphabet") { parameters.alphabet_size = std::strtoull(value, nullptr, 10); }
+        else if (option == "--degree") { parameters.out_degree = std::strtod(value, nullptr); }
+        else if (option == "--distribution" && distributions.contains(value)) {
+            parameters.distribution = distributions.at(value);
+        }
+        else if (option == "--epsilon") { parameters.epsilon_density = std::strtod(value, nullptr); }
+        else if (option == "--finals") { parameters.final_density = std::strtod(value, nullptr); }
+        else if (option == "--counters") { parameters.num_of_counters = std::strtoull(value, nullptr, 10); }
+        else if (option == "--annotations") { parameters.annotation_density = std::strtod(value, nullptr); }
+        else if (option == "--bound") { parameters.max_bound = std::strtoull(value, nullptr, 10); }
+        else if (option == "--decrements") { parameters.decrements = std::strtoull(value, nullptr, 10) != 0; }
+        else if (option == "--output") { output_path = value; }
+        else if (option == "--words") { corpus.num_of_words = std::strtoull(value, nullptr, 10); }
+        else if (option == "--length") { corpus.length = std::strtoull(value, nullptr, 10); }
+        else if (option == "--matching") { matching_path = value; }
+        else if (option == "--non-matching") { non_matching_path = value; }
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    // Words are written one per line.
+    if (parameters.first_symbol <= '\n' && '\n' < parameters.first_symbol + parameters.alphabet_size) {
+        std::cerr << "The alphabet must not contain the newline.\n";
+        return 1;
+    }
+    corpus.seed = parameters.seed;
+    corpus.alphabet_size = parameters.alphabet_size;
+    corpus.first_symbol = parameters.first_symbol;
+
+    Nfa nfa{};
+    try {
+        nfa = generateNfa(parameters);
+    } catch (const std::invalid_argument& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+    if (output_path.empty()) {
+        writeMata(nfa, std::cout);
+    } else {
+        std::ofstream output{ output_path };
+        writeMata(nfa, output);
+        if (!output) {
+            std::cerr << "Cannot write " << output_path << "\n";
+            return 1;
+        }
+    }
+
+    if (!matching_path.empty()) {
+        const std::vector<std::string> words{ generateMatchingWords(nfa, corpus) };
+        if (!writeWords(words, matching_path)) {
+            std::cerr << "Cannot write " << matching_path << "\n";
+            return 1;
+        }
+        if (words.size() < corpus.num_of_words) {
+            std::cerr << "Only " << words.size() << " matching words found.\n";
+        }
+    }
+    if (!non_matching_path.empty()) {
+        const std::vector<std::string> words{ generateNonMatchingWords(nfa, corpus) };
+        if (!writeWords(words, non_matching_path)) {
+            std::cerr << "Cannot write " << non_matching_path << "\n";
+            return 1;
+        }
+        if (words.size() < corpus.num_of_words) {
+            std::cerr << "Only " << words.size() << " non-matching words found.\n";
+        }
+    }
+    return 0;
+}
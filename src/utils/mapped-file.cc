@@ -0,0 +1,34 @@
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../../include/mata/utils/mapped-file.hh"
+
+using mata::utils::MappedFile;
+
+MappedFile::MappedFile(const std::string& path) {
+    const int file{ ::open(path.c_str(), O_RDONLY) };
+    if (file < 0) { throw std::runtime_error("MappedFile: Cannot open " + path + "."); }
+    struct stat status{};
+    if (::fstat(file, &status) != 0) {
+        ::close(file);
+        throw std::runtime_error("MappedFile: Cannot read the size of " + path + ".");
+    }
+    size_ = static_cast<size_t>(status.st_size);
+    // An empty file cannot be mapped, it is represented by an empty range.
+    void* address{ size_ == 0 ? nullptr : ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, file, 0) };
+    ::close(file);
+    if (address == MAP_FAILED) { throw std::runtime_error("MappedFile: Cannot map " + path + "."); }
+    address_ = address;
+}
+
+MappedFile::~MappedFile() {
+    if (address_ != nullptr) { ::munmap(address_, size_); }
+}
+
+void MappedFile::adviseSequential() const {
+    if (address_ != nullptr) { ::madvise(address_, size_, MADV_SEQUENTIAL); }
+}
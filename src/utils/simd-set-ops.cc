@@ -0,0 +1,299 @@
+// Block-based kernels for sorted sets: blocks of WIDTH elements of both inputs are compared all-to-all with a few
+//  vector instructions, and the block with the smaller maximum is advanced (both if the maxima are equal). Every pair
+//  of equal elements meets in exactly one block comparison, so the matches come out in order. The rest after the last
+//  full blocks is processed by a scalar merge.
+//
+// The kernels are templates instantiated in wrappers compiled for the given instruction set. The wrappers are
+//  flattened so that the block comparison is inlined into the kernel loop.
+
+#include <initializer_list>
+
+#include "../../include/mata/utils/simd-set-ops.hh"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MATA_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace mata::utils::simd;
+
+namespace {
+
+/// Scalar merge of @p lhs [@p i, @p lhs_size) with @p rhs [@p j, @p rhs_size).
+/// Elements of @p lhs at positions [@p i, @p i + 32) whose bit is set in @p skip are treated as already matched.
+template<bool EMIT_MATCHED>
+size_t merge_tail(const Element* lhs, size_t i, const size_t lhs_size, const Element* rhs, size_t j,
+                  const size_t rhs_size, Element* result, size_t k, const unsigned skip = 0) {
+    const size_t block_start{ i };
+    for (; i < lhs_size; ++i) {
+        if (i - block_start < 32 && (skip >> (i - block_start)) & 1u) { continue; }
+        while (j < rhs_size && rhs[j] < lhs[i]) { ++j; }
+        const bool matched{ j < rhs_size && rhs[j] == lhs[i] };
+        if (matched == EMIT_MATCHED) { result[k++] = lhs[i]; }
+    }
+    return k;
+}
+
+/// Like @c merge_tail<false>, but only checks whether there is any unmatched element.
+bool has_unmatched_tail(const Element* lhs, size_t i, const size_t lhs_size, const Element* rhs, size_t j,
+                        const size_t rhs_size, const unsigned skip = 0) {
+    const size_t block_start{ i };
+    for (; i < lhs_size; ++i) {
+        if (i - block_start < 32 && (skip >> (i - block_start)) & 1u) { continue; }
+        while (j < rhs_size && rhs[j] < lhs[i]) { ++j; }
+        if (j == rhs_size || rhs[j] != lhs[i]) { return true; }
+    }
+    return false;
+}
+
+bool has_match_tail(const Element* lhs, size_t i, const size_t lhs_size, const Element* rhs, size_t j,
+                    const size_t rhs_size) {
+    while (i < lhs_size && j < rhs_size) {
+        if (lhs[i] == rhs[j]) { return true; }
+        if (lhs[i] < rhs[j]) { ++i; } else { ++j; }
+    }
+    return false;
+}
+
+struct ScalarBlock {
+    static constexpr size_t WIDTH{ 1 };
+    static unsigned match(const Element* lhs, const Element* rhs) { return *lhs == *rhs; }
+};
+
+#ifdef MATA_SIMD_X86
+struct Sse41Block {
+    static constexpr size_t WIDTH{ 2 };
+    __attribute__((target("sse4.1")))
+    static unsigned match(const Element* lhs, const Element* rhs) {
+        const __m128i lhs_block{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs)) };
+        const __m128i rhs_block{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs)) };
+        const __m128i rhs_swapped{ _mm_shuffle_epi32(rhs_block, _MM_SHUFFLE(1, 0, 3, 2)) };
+        const __m128i matches{ _mm_or_si128(_mm_cmpeq_epi64(lhs_block, rhs_block),
+                                            _mm_cmpeq_epi64(lhs_block, rhs_swapped)) };
+        return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(matches)));
+    }
+};
+
+struct Avx2Block {
+    static constexpr size_t WIDTH{ 4 };
+    __attribute__((target("avx2")))
+    static unsigned match(const Element* lhs, const Element* rhs) {
+        const __m256i lhs_block{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs)) };
+        const __m256i rhs_block{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs)) };
+        const __m256i matches0{ _mm256_cmpeq_epi64(lhs_block, rhs_block) };
+        const __m256i matches1{ _mm256_cmpeq_epi64(lhs_block,
+                                                   _mm256_permute4x64_epi64(rhs_block, _MM_SHUFFLE(0, 3, 2, 1))) };
+        const __m256i matches2{ _mm256_cmpeq_epi64(lhs_block,
+                                                   _mm256_permute4x64_epi64(rhs_block, _MM_SHUFFLE(1, 0, 3, 2))) };
+        const __m256i matches3{ _mm256_cmpeq_epi64(lhs_block,
+                                                   _mm256_permute4x64_epi64(rhs_block, _MM_SHUFFLE(2, 1, 0, 3))) };
+        const __m256i matches{ _mm256_or_si256(_mm256_or_si256(matches0, matches1),
+                                               _mm256_or_si256(matches2, matches3)) };
+        return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(matches)));
+    }
+};
+#endif
+
+template<class Block>
+size_t intersection_kernel(const Element* lhs, const size_t lhs_size, const Element* rhs, const size_t rhs_size,
+                           Element* result) {
+    constexpr size_t WIDTH{ Block::WIDTH };
+    size_t i{ 0 }, j{ 0 }, k{ 0 };
+    if (lhs_size >= WIDTH && rhs_size >= WIDTH) {
+        while (true) {
+            for (unsigned matches{ Block::match(lhs + i, rhs + j) }; matches != 0; matches &= matches - 1) {
+                result[k++] = lhs[i + static_cast<size_t>(__builtin_ctz(matches))];
+            }
+            const Element lhs_max{ lhs[i + WIDTH - 1] };
+            const Element rhs_max{ rhs[j + WIDTH - 1] };
+            if (lhs_max <= rhs_max) { i += WIDTH; }
+            if (rhs_max <= lhs_max) { j += WIDTH; }
+            if (i + WIDTH > lhs_size || j + WIDTH > rhs_size) { break; }
+        }
+    }
+    return merge_tail<true>(lhs, i, lhs_size, rhs, j, rhs_size, result, k);
+}
+
+template<class Block>
+size_t difference_kernel(const Element* lhs, const size_t lhs_size, const Element* rhs, const size_t rhs_size,
+                         Element* result) {
+    constexpr size_t WIDTH{ Block::WIDTH };
+    size_t i{ 0 }, j{ 0 }, k{ 0 };
+    unsigned matched{ 0 }; // Elements of the current lhs block matched so far.
+    if (lhs_size >= WIDTH && rhs_size >= WIDTH) {
+        while (true) {
+            matched |= Block::match(lhs + i, rhs + j);
+            const Element lhs_max{ lhs[i + WIDTH - 1] };
+            const Element rhs_max{ rhs[j + WIDTH - 1] };
+            if (lhs_max <= rhs_max) {
+                for (size_t offset{ 0 }; offset < WIDTH; ++offset) {
+                    if (!((matched >> offset) & 1u)) { result[k++] = lhs[i + offset]; }
+                }
+                matched = 0;
+                i += WIDTH;
+            }
+            if (rhs_max <= lhs_max) { j += WIDTH; }
+            if (i + WIDTH > lhs_size || j + WIDTH > rhs_size) { break; }
+        }
+    }
+    return merge_tail<false>(lhs, i, lhs_size, rhs, j, rhs_size, result, k, matched);
+}
+
+template<class Block>
+bool is_intersection_empty_kernel(const Element* lhs, const size_t lhs_size, const Element* rhs,
+                                  const size_t rhs_size) {
+    constexpr size_t WIDTH{ Block::WIDTH };
+    size_t i{ 0 }, j{ 0 };
+    if (lhs_size >= WIDTH && rhs_size >= WIDTH) {
+        while (true) {
+            if (Block::match(lhs + i, rhs + j) != 0) { return false; }
+            const Element lhs_max{ lhs[i + WIDTH - 1] };
+            const Element rhs_max{ rhs[j + WIDTH - 1] };
+            if (lhs_max <= rhs_max) { i += WIDTH; }
+            if (rhs_max <= lhs_max) { j += WIDTH; }
+            if (i + WIDTH > lhs_size || j + WIDTH > rhs_size) { break; }
+        }
+    }
+    return !has_match_tail(lhs, i, lhs_size, rhs, j, rhs_size);
+}
+
+template<class Block>
+bool is_subset_of_kernel(const Element* lhs, const size_t lhs_size, const Element* rhs, const size_t rhs_size) {
+    constexpr size_t WIDTH{ Block::WIDTH };
+    constexpr unsigned ALL_MATCHED{ (1u << WIDTH) - 1 };
+    if (lhs_size > rhs_size) { return false; }
+    size_t i{ 0 }, j{ 0 };
+    unsigned matched{ 0 };
+    if (lhs_size >= WIDTH && rhs_size >= WIDTH) {
+        while (true) {
+            matched |= Block::match(lhs + i, rhs + j);
+            const Element lhs_max{ lhs[i + WIDTH - 1] };
+            const Element rhs_max{ rhs[j + WIDTH - 1] };
+            if (lhs_max <= rhs_max) {
+                if (matched != ALL_MATCHED) { return false; }
+                matched = 0;
+                i += WIDTH;
+            }
+            if (rhs_max <= lhs_max) { j += WIDTH; }
+            if (i + WIDTH > lhs_size || j + WIDTH > rhs_size) { break; }
+        }
+    }
+    return !has_unmatched_tail(lhs, i, lhs_size, rhs, j, rhs_size, matched);
+}
+
+struct Kernels {
+    size_t (*intersection)(const Element*, size_t, const Element*, size_t, Element*);
+    size_t (*difference)(const Element*, size_t, const Element*, size_t, Element*);
+    bool (*is_intersection_empty)(const Element*, size_t, const Element*, size_t);
+    bool (*is_subset_of)(const Element*, size_t, const Element*, size_t);
+};
+
+constexpr Kernels SCALAR_KERNELS{
+    intersection_kernel<ScalarBlock>, difference_kernel<ScalarBlock>,
+    is_intersection_empty_kernel<ScalarBlock>, is_subset_of_kernel<ScalarBlock>,
+};
+
+#ifdef MATA_SIMD_X86
+#define MATA_SIMD_WRAPPERS(TARGET, BLOCK, SUFFIX) \
+    __attribute__((target(TARGET), flatten)) \
+    size_t intersection_##SUFFIX(const Element* lhs, size_t lhs_size, const Element* rhs, size_t rhs_size, \
+                                 Element* result) { \
+        return intersection_kernel<BLOCK>(lhs, lhs_size, rhs, rhs_size, result); \
+    } \
+    __attribute__((target(TARGET), flatten)) \
+    size_t difference_##SUFFIX(const Element* lhs, size_t lhs_size, const Element* rhs, size_t rhs_size, \
+                               Element* result) { \
+        return difference_kernel<BLOCK>(lhs, lhs_size, rhs, rhs_size, result); \
+    } \
+    __attribute__((target(TARGET), flatten)) \
+    bool is_intersection_empty_##SUFFIX(const Element* lhs, size_t lhs_size, const Element* rhs, size_t rhs_size) { \
+        return is_intersection_empty_kernel<BLOCK>(lhs, lhs_size, rhs, rhs_size); \
+    } \
+    __attribute__((target(TARGET), flatten)) \
+    bool is_subset_of_##SUFFIX(const Element* lhs, size_t lhs_size, const Element* rhs, size_t rhs_size) { \
+        return is_subset_of_kernel<BLOCK>(lhs, lhs_size, rhs, rhs_size); \
+    }
+
+MATA_SIMD_WRAPPERS("sse4.1", Sse41Block, sse41)
+MATA_SIMD_WRAPPERS("avx2", Avx2Block, avx2)
+#undef MATA_SIMD_WRAPPERS
+
+constexpr Kernels SSE41_KERNELS{ intersection_sse41, difference_sse41, is_intersection_empty_sse41, is_subset_of_sse41 };
+constexpr Kernels AVX2_KERNELS{ intersection_avx2, difference_avx2, is_intersection_empty_avx2, is_subset_of_avx2 };
+#endif
+
+bool is_supported(const InstructionSet instruction_set) {
+    switch (instruction_set) {
+        case InstructionSet::Scalar: return true;
+#ifdef MATA_SIMD_X86
+        case InstructionSet::Sse41: __builtin_cpu_init(); return __builtin_cpu_supports("sse4.1");
+        case InstructionSet::Avx2: __builtin_cpu_init(); return __builtin_cpu_supports("avx2");
+#endif
+        default: return false;
+    }
+}
+
+struct Dispatch {
+    InstructionSet instruction_set{ InstructionSet::Scalar };
+    Kernels kernels{ SCALAR_KERNELS };
+
+    Dispatch() {
+        for (const InstructionSet best : { InstructionSet::Avx2, InstructionSet::Sse41 }) {
+            if (select(best)) { break; }
+        }
+    }
+
+    bool select(const InstructionSet selected) {
+        if (!is_supported(selected)) { return false; }
+        instruction_set = selected;
+        switch (selected) {
+#ifdef MATA_SIMD_X86
+            case InstructionSet::Sse41: kernels = SSE41_KERNELS; break;
+            case InstructionSet::Avx2: kernels = AVX2_KERNELS; break;
+#endif
+            default: kernels = SCALAR_KERNELS; break;
+        }
+        return true;
+    }
+};
+
+Dispatch& dispatch() {
+    static Dispatch dispatch{};
+    return dispatch;
+}
+
+} // namespace.
+
+bool mata::utils::simd::set_instruction_set(const InstructionSet instruction_set) {
+    return dispatch().select(instruction_set);
+}
+
+InstructionSet mata::utils::simd::get_instruction_set() { return dispatch().instruction_set; }
+
+const char* mata::utils::simd::to_string(const InstructionSet instruction_set) {
+    switch (instruction_set) {
+        case InstructionSet::Sse41: return "sse4.1";
+        case InstructionSet::Avx2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+size_t mata::utils::simd::intersection(const Element* lhs, const size_t lhs_size, const Element* rhs,
+                                       const size_t rhs_size, Element* result) {
+    return dispatch().kernels.intersection(lhs, lhs_size, rhs, rhs_size, result);
+}
+
+size_t mata::utils::simd::difference(const Element* lhs, const size_t lhs_size, const Element* rhs,
+                                     const size_t rhs_size, Element* result) {
+    return dispatch().kernels.difference(lhs, lhs_size, rhs, rhs_size, result);
+}
+
+bool mata::utils::simd::is_intersection_empty(const Element* lhs, const size_t lhs_size, const Element* rhs,
+                                              const size_t rhs_size) {
+    return dispatch().kernels.is_intersection_empty(lhs, lhs_size, rhs, rhs_size);
+}
+
+bool mata::utils::simd::is_subset_of(const Element* lhs, const size_t lhs_size, const Element* rhs,
+                                     const size_t rhs_size) {
+    return dispatch().kernels.is_subset_of(lhs, lhs_size, rhs, rhs_size);
+}
@@ -0,0 +1,287 @@
+// Counter-aware simulation compared with a naive simulation over explicit configurations, and the guards compiled
+//  by Theta compared with executing the annotations one by one.
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test.hh"
+#include "mata/nfa/generator.hh"
+#include "mata/nfa/nfa.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+constexpr CounterValue MAX_VALUE{ std::numeric_limits<CounterValue>::max() };
+
+/// Execute @p annotations in order on @p values with exact arithmetic. @return False if the transition is disabled.
+bool execute(const std::span<const Annotation> annotations, const CounterSet& initial,
+             std::vector<CounterValue>& values) {
+    for (const Annotation& annotation : annotations) {
+        CounterValue& value{ values[annotation.counter_id] };
+        switch (annotation.opcode) {
+            case Annotation::Opcode::Increment:
+                if (value > MAX_VALUE - annotation.operand) { return false; }
+                value += annotation.operand;
+                break;
+            case Annotation::Opcode::Decrement:
+                if (value < annotation.operand) { return false; }
+                value -= annotation.operand;
+                break;
+            case Annotation::Opcode::Reset: value = initial[annotation.counter_id].initial_value; break;
+            case Annotation::Opcode::TestEqual:
+                if (value != annotation.operand) { return false; }
+                break;
+            case Annotation::Opcode::TestLess:
+                if (value >= annotation.operand) { return false; }
+                break;
+            case Annotation::Opcode::TestGreaterEqual:
+                if (value < annotation.operand) { return false; }
+                break;
+            case Annotation::Opcode::TestInRange:
+                if (value < annotation.operand || value > annotation.upper) { return false; }
+                break;
+        }
+    }
+    return true;
+}
+
+using Configurations = std::set<std::pair<State, std::vector<CounterValue>>>;
+
+/// Successors of @p configurations over @p symbol (without the epsilon closure), or the epsilon closure of
+///  @p configurations if @p symbol is @c EPSILON.
+Configurations step(const Nfa& nfa, const Configurations& configurations, const Symbol symbol) {
+    Configurations result{ symbol == EPSILON ? configurations : Configurations{} };
+    std::vector<std::pair<State, std::vector<CounterValue>>> worklist(configurations.begin(), configurations.end());
+    while (!worklist.empty()) {
+        const auto [state, values]{ std::move(worklist.back()) };
+        worklist.pop_back();
+        if (state >= nfa.delta.numStates()) { continue; }
+        for (const SymbolPost& symbol_post : nfa.delta.getStatePost(state)) {
+            if (symbol_post.symbol != symbol) { continue; }
+            for (const Target& target : symbol_post.targets) {
+                std::vector<CounterValue> successor_values{ values };
+                if (target.annotation_id != UNDEFINED_ID
+                    && !execute(nfa.theta[target.annotation_id], nfa.counters, successor_values)) {
+                    continue;
+                }
+                if (result.emplace(target.state, successor_values).second && symbol == EPSILON) {
+                    worklist.emplace_back(target.state, std::move(successor_values));
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/// Naive simulation over explicit configurations (state, values of all counters).
+bool reference_simulate(const Nfa& nfa, const std::string& input) {
+    std::vector<CounterValue> initial_values{};
+    for (size_t counter{ 0 }; counter < nfa.counters.size(); ++counter) {
+        initial_values.push_back(nfa.counters[counter].initial_value);
+    }
+    Configurations configurations{};
+    for (const State state : nfa.initial) { configurations.emplace(state, initial_values); }
+    configurations = step(nfa, configurations, EPSILON);
+    for (const char c : input) {
+        // A NUL byte is the symbol EPSILON, which matches no transition.
+        if (toSymbol(c) == EPSILON) { return false; }
+        configurations = step(nfa, step(nfa, configurations, toSymbol(c)), EPSILON);
+    }
+    return std::any_of(configurations.begin(), configurations.end(),
+                       [&](const auto& configuration) { return nfa.final.contains(configuration.first); });
+}
+
+/// Random group of one to three annotations of any kind with small operands (tests only if @p epsilon).
+std::vector<Annotation> random_annotations(test::Random& random, const size_t num_of_counters, const bool epsilon) {
+    std::vector<Annotation> annotations(1 + test::below(random, 3));
+    for (Annotation& annotation : annotations) {
+        const size_t counter{ test::below(random, num_of_counters) };
+        const CounterValue operand{ test::below(random, 5) };
+        switch (epsilon ? 3 + test::below(random, 4) : test::below(random, 7)) {
+            case 0: annotation = Annotation::increment(counter, operand); break;
+            case 1: annotation = Annotation::decrement(counter, operand); break;
+            case 2: annotation = Annotation::reset(counter); break;
+            case 3: annotation = Annotation::testEqual(counter, operand); break;
+            case 4: annotation = Annotation::testLess(counter, operand); break;
+            case 5: annotation = Annotation::testGreaterEqual(counter, operand); break;
+            default: annotation = Annotation::testInRange(counter, operand, operand + test::below(random, 4)); break;
+        }
+    }
+    return annotations;
+}
+
+/// Random small automaton whose transitions carry random groups of annotations.
+Nfa random_nfa(test::Random& random) {
+    const size_t num_of_states{ 1 + test::below(random, 6) };
+    const size_t num_of_counters{ 1 + test::below(random, 3) };
+    Nfa nfa{};
+    nfa.delta = Delta{ num_of_states };
+    for (size_t counter{ 0 }; counter < num_of_counters; ++counter) {
+        nfa.counters.addCounter(test::below(random, 3));
+    }
+    const size_t num_of_transitions{ test::below(random, 3 * num_of_states + 1) };
+    for (size_t i{ 0 }; i < num_of_transitions; ++i) {
+        const State source{ test::below(random, num_of_states) };
+        const State target{ test::below(random, num_of_states) };
+        const bool epsilon{ test::below(random, 8) == 0 };
+        const Symbol symbol{ epsilon ? EPSILON : static_cast<Symbol>('a' + test::below(random, 2)) };
+        if (test::below(random, 3) == 0) {
+            nfa.delta.add(source, symbol, target);
+        } else {
+            const size_t annotation_id{ nfa.theta.add(random_annotations(random, num_of_counters, epsilon)) };
+            nfa.delta.add(source, symbol, target, annotation_id);
+        }
+    }
+    nfa.addInitialState(test::below(random, num_of_states));
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        if (test::below(random, 3) == 0) { nfa.addFinalState(state); }
+    }
+    return nfa;
+}
+
+/// Compare the simulation of @p nfa with the reference on the empty word and on random words.
+void check_simulation(test::Random& random, const Nfa& nfa, const std::string& name) {
+    for (size_t length{ 0 }; length <= 12; ++length) {
+        std::string word{ test::random_word(random, length) };
+        // Some words with a NUL byte, which must not follow epsilon transitions.
+        if (length > 0 && length % 4 == 0) { word[test::below(random, length)] = '\0'; }
+        if (!test::check(nfa.simulateWithCounters(word) == reference_simulate(nfa, word),
+                         name + " on \"" + word + "\"")) {
+            return;
+        }
+    }
+}
+
+/// Random values of counters: small values and values near the largest value, where the compiled guards must not
+///  overflow.
+CounterValue random_value(test::Random& random) {
+    return test::below(random, 2) == 0 ? test::below(random, 8) : MAX_VALUE - test::below(random, 8);
+}
+
+/// Compare Theta::execute() (compiled guards and actions) with executing the annotations of the group in order.
+void check_compiled_guards(test::Random& random) {
+    constexpr size_t NUM_OF_COUNTERS{ 2 };
+    std::vector<Annotation> annotations(test::below(random, 5));
+    for (Annotation& annotation : annotations) {
+        const size_t counter{ test::below(random, NUM_OF_COUNTERS) };
+        const CounterValue operand{ random_value(random) };
+        switch (test::below(random, 7)) {
+            case 0: annotation = Annotation::increment(counter, operand); break;
+            case 1: annotation = Annotation::decrement(counter, operand); break;
+            case 2: annotation = Annotation::reset(counter); break;
+            case 3: annotation = Annotation::testEqual(counter, operand); break;
+            case 4: annotation = Annotation::testLess(counter, operand); break;
+            case 5: annotation = Annotation::testGreaterEqual(counter, operand); break;
+            default: annotation = Annotation::testInRange(counter, std::min(operand, random_value(random)), operand);
+        }
+    }
+    Theta theta{};
+    const size_t annotation_id{ theta.add(annotations) };
+
+    CounterSet counters{};
+    for (size_t counter{ 0 }; counter < NUM_OF_COUNTERS; ++counter) { counters.addCounter(random_value(random)); }
+    for (size_t i{ 0 }; i < 8; ++i) {
+        std::vector<CounterValue> values{};
+        for (size_t counter{ 0 }; counter < NUM_OF_COUNTERS; ++counter) {
+            counters[counter].value = random_value(random);
+            values.push_back(counters[counter].value);
+        }
+        const bool expected{ execute(annotations, counters, values) };
+        // The guards are necessary conditions only: overflows of increments and tests after a reset are left to
+        //  the actions.
+        test::check(!expected || theta.test(annotation_id, counters), "Theta::test");
+        CounterSet updated{ counters };
+        if (!test::check(theta.execute(annotation_id, updated) == expected, "Theta::execute")) { return; }
+        if (expected) {
+            for (size_t counter{ 0 }; counter < NUM_OF_COUNTERS; ++counter) {
+                test::check(updated[counter].value == values[counter], "Theta::execute: value of the counter");
+            }
+        }
+    }
+}
+
+/**
+ * Loop over 'a' shifting a counter kept in a counting set by operands near the largest value, followed by a test on
+ *  'b'. The values must be shifted with exact arithmetic, without a signed type overflowing.
+ * @return Number of checked automata.
+ */
+size_t check_large_shifts() {
+    constexpr CounterValue HALF{ CounterValue{ 1 } << 63 };
+    const std::vector<std::vector<Annotation>> loops{
+        { Annotation::testLess(0, 5), Annotation::increment(0, HALF + 1) },
+        { Annotation::testLess(0, 5), Annotation::increment(0, MAX_VALUE) },
+        { Annotation::testLess(0, 5), Annotation::increment(0, HALF), Annotation::increment(0, HALF) },
+        { Annotation::testLess(0, 5), Annotation::increment(0, MAX_VALUE), Annotation::decrement(0, MAX_VALUE) },
+        { Annotation::testLess(0, 5), Annotation::increment(0, MAX_VALUE - 2), Annotation::decrement(0, HALF) },
+    };
+    const std::vector<std::vector<Annotation>> exits{
+        { Annotation::testLess(0, 5) },
+        { Annotation::testGreaterEqual(0, HALF) },
+        { Annotation::testInRange(0, MAX_VALUE - 4, MAX_VALUE) },
+    };
+    size_t num_of_cases{ 0 };
+    for (const std::vector<Annotation>& loop : loops) {
+        for (const std::vector<Annotation>& exit : exits) {
+            Nfa nfa{};
+            nfa.delta = Delta{ 2 };
+            nfa.counters.addCounter(0);
+            nfa.delta.add(0, 'a', 0, nfa.theta.add(loop));
+            nfa.delta.add(0, 'b', 1, nfa.theta.add(exit));
+            nfa.addInitialState(0);
+            nfa.addFinalState(1);
+            for (const std::string word : { "", "b", "ab", "aab", "aaab" }) {
+                test::check(nfa.simulateWithCounters(word) == reference_simulate(nfa, word),
+                            "large shift " + std::to_string(num_of_cases) + " on \"" + word + "\"");
+            }
+            ++num_of_cases;
+        }
+    }
+    return num_of_cases;
+}
+
+} // namespace.
+
+int main() {
+    test::Random random{ 2024 };
+    size_t num_of_cases{ 0 };
+    for (size_t i{ 0 }; i < 2000; ++i) {
+        check_simulation(random, random_nfa(random), "random automaton " + std::to_string(i));
+        ++num_of_cases;
+    }
+    for (uint64_t seed{ 0 }; seed < 200; ++seed) {
+        GeneratorParameters parameters{};
+        parameters.seed = seed;
+        parameters.num_of_states = 2 + seed % 10;
+        parameters.alphabet_size = 2;
+        parameters.epsilon_density = 0.1;
+        parameters.num_of_counters = 1 + seed % 3;
+        parameters.annotation_density = 0.5;
+        parameters.max_bound = 1 + seed % 6;
+        parameters.decrements = seed % 2 == 1;
+        const Nfa nfa{ generateNfa(parameters) };
+        check_simulation(random, nfa, "generated automaton " + std::to_string(seed));
+
+        // Words accepted by runs which execute the annotations.
+        CorpusParameters corpus_parameters{};
+        corpus_parameters.seed = seed;
+        corpus_parameters.num_of_words = 5;
+        corpus_parameters.length = 8;
+        corpus_parameters.alphabet_size = 2;
+        for (const std::string& word : generateMatchingWords(nfa, corpus_parameters)) {
+            test::check(nfa.simulateWithCounters(word) && reference_simulate(nfa, word),
+                        "generated automaton " + std::to_string(seed) + " on the matching word \"" + word + "\"");
+        }
+        ++num_of_cases;
+    }
+    for (size_t i{ 0 }; i < 20000; ++i) {
+        check_compiled_guards(random);
+        ++num_of_cases;
+    }
+    num_of_cases += check_large_shifts();
+    return test::finish("counter-simulation", num_of_cases);
+}
@@ -0,0 +1,155 @@
+// Construction of Delta compared with simple references: DeltaBuilder (sorting by radix sort or by comparisons) with
+//  Delta::add(), and annotated targets added in any way with a std::set of (source, symbol, state, annotation ID).
+
+#include <algorithm>
+#include <optional>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "test.hh"
+#include "mata/nfa/delta-builder.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+/// Transitions as (source, symbol, target state, annotation ID).
+using Transitions = std::set<std::tuple<State, Symbol, State, size_t>>;
+
+/// Transitions of @p delta, or std::nullopt if some target set is not sorted and without duplicates.
+std::optional<Transitions> transitions_of(const Delta& delta) {
+    Transitions transitions{};
+    for (State source{ 0 }; source < delta.numStates(); ++source) {
+        for (const SymbolPost& symbol_post : delta.getStatePost(source)) {
+            if (!std::is_sorted(symbol_post.targets.begin(), symbol_post.targets.end())) { return std::nullopt; }
+            for (const Target& target : symbol_post.targets) {
+                if (!transitions.emplace(source, symbol_post.symbol, target.state, target.annotation_id).second) {
+                    return std::nullopt;
+                }
+            }
+        }
+    }
+    return transitions;
+}
+
+struct Transition {
+    State source;
+    Symbol symbol;
+    State target;
+};
+
+/// Build a delta from @p transitions by DeltaBuilder and by Delta::add() and compare them.
+void check_builder(DeltaBuilder& builder, const std::vector<Transition>& transitions, const size_t num_of_states,
+                   const std::string& name) {
+    State max_state{ 0 };
+    for (const Transition& transition : transitions) {
+        builder.add(transition.source, transition.symbol, transition.target);
+        max_state = std::max({ max_state, transition.source, transition.target });
+    }
+    test::check(builder.size() == transitions.size(), name + ": size");
+    const Delta built{ builder.build(num_of_states) };
+    test::check(builder.empty(), name + ": the builder is not cleared");
+
+    Delta expected{ transitions.empty() ? num_of_states : std::max<size_t>(num_of_states, max_state + 1) };
+    for (const Transition& transition : transitions) {
+        expected.add(transition.source, transition.symbol, transition.target);
+    }
+    test::check(built.numStates() == expected.numStates(), name + ": number of states");
+    const std::optional<Transitions> built_transitions{ transitions_of(built) };
+    test::check(built_transitions.has_value() && built_transitions == transitions_of(expected),
+                name + ": transitions");
+}
+
+/// Random transitions over states [0, @p num_of_states) and symbols [0, @p num_of_symbols), with duplicates.
+std::vector<Transition> random_transitions(test::Random& random, const size_t size, const State num_of_states,
+                                           const uint64_t num_of_symbols) {
+    std::vector<Transition> transitions(size);
+    for (Transition& transition : transitions) {
+        transition = { test::below(random, num_of_states), static_cast<Symbol>(test::below(random, num_of_symbols)),
+                       test::below(random, num_of_states) };
+    }
+    return transitions;
+}
+
+size_t check_builders(test::Random& random) {
+    size_t num_of_cases{ 0 };
+    DeltaBuilder builder{};
+    const auto check = [&](const std::vector<Transition>& transitions, const size_t num_of_states, const char* kind) {
+        check_builder(builder, transitions, num_of_states, std::string{ kind } + " with "
+                                                           + std::to_string(transitions.size()) + " transitions");
+        ++num_of_cases;
+    };
+
+    check({}, 0, "empty");
+    check({}, 5, "empty");
+    for (const size_t size : { 1, 2, 3, 7, 100, 1000 }) {
+        // Dense: many duplicates. Wide symbols: keys of more than 64 bits, sorted by comparisons.
+        check(random_transitions(random, size, 4, 2), 0, "dense");
+        check(random_transitions(random, size, 50, 256), 10, "random");
+        check(random_transitions(random, size, 100000, 4), 0, "many states");
+        check(random_transitions(random, size, 70000, uint64_t{ 1 } << 32), 0, "wide symbols");
+        check(std::vector<Transition>(size, { 3, 'a', 7 }), 0, "equal");
+
+        std::vector<Transition> sorted{};
+        for (State source{ 0 }; sorted.size() < size; ++source) {
+            for (Symbol symbol{ 0 }; symbol < 3; ++symbol) { sorted.push_back({ source, symbol, source + symbol }); }
+        }
+        check(sorted, 0, "sorted");
+        std::vector<Transition> reversed{ sorted.rbegin(), sorted.rend() };
+        check(reversed, 0, "reversed");
+    }
+    return num_of_cases;
+}
+
+/// Add annotated targets, plain targets and sets of plain targets in random order; plain targets are targets without
+///  an annotation (@c UNDEFINED_ID), so the same state may be a target with several annotation IDs.
+void check_annotated_targets(test::Random& random, const size_t num_of_operations) {
+    Delta delta{};
+    Transitions reference{};
+    for (size_t i{ 0 }; i < num_of_operations; ++i) {
+        const State source{ test::below(random, 3) };
+        const Symbol symbol{ static_cast<Symbol>(test::below(random, 2)) };
+        switch (test::below(random, 3)) {
+            case 0: {
+                const State target{ test::below(random, 8) };
+                const size_t annotation_id{ test::below(random, 3) };
+                delta.add(source, symbol, target, annotation_id);
+                reference.emplace(source, symbol, target, annotation_id);
+                break;
+            }
+            case 1: {
+                const State target{ test::below(random, 8) };
+                delta.add(source, symbol, target);
+                reference.emplace(source, symbol, target, UNDEFINED_ID);
+                break;
+            }
+            default: {
+                StateSet targets{};
+                for (const uint64_t target : test::random_set(random, test::below(random, 5), 8)) {
+                    targets.insert(target);
+                    reference.emplace(source, symbol, target, UNDEFINED_ID);
+                }
+                delta.add(source, symbol, targets);
+                break;
+            }
+        }
+        if (!test::check(transitions_of(delta) == reference, "annotated targets: step " + std::to_string(i))) {
+            return;
+        }
+    }
+}
+
+} // namespace.
+
+int main() {
+    test::Random random{ 2024 };
+    size_t num_of_cases{ 0 };
+    for (size_t run{ 0 }; run < 5; ++run) { num_of_cases += check_builders(random); }
+    for (size_t run{ 0 }; run < 50; ++run) {
+        check_annotated_targets(random, 200);
+        ++num_of_cases;
+    }
+    return test::finish("delta", num_of_cases);
+}
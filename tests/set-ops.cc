@@ -0,0 +1,135 @@
+// Vectorized set operations (mata/utils/simd-set-ops.hh) compared with the standard algorithms, for every
+//  instruction set supported by the CPU.
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "test.hh"
+#include "mata/utils/ord-vector.hh"
+#include "mata/utils/simd-set-ops.hh"
+
+using namespace mata::utils;
+using simd::Element;
+
+namespace {
+
+/// Sizes around the block widths of the kernels, so that every length of the scalar tail is covered.
+const std::vector<size_t> SIZES{ 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 257 };
+
+/// Offsets of the values: small numbers, numbers around the sign bit and numbers at the top of the range, so that
+///  comparisons of the kernels must be unsigned.
+const std::vector<Element> BASES{ 0, (Element{ 1 } << 63) - 64, std::numeric_limits<Element>::max() - 4096 };
+
+std::vector<Element> shifted(std::vector<Element> set, const Element base) {
+    for (Element& element : set) { element += base; }
+    return set;
+}
+
+/// Copy of @p set starting one element past an aligned address, so that the loads of the kernels are unaligned.
+struct Unaligned {
+    explicit Unaligned(const std::vector<Element>& set) : storage(set.size() + 1) {
+        std::copy(set.begin(), set.end(), storage.begin() + 1);
+    }
+    const Element* data() const { return storage.data() + 1; }
+
+    std::vector<Element> storage;
+};
+
+void check_operations(const std::vector<Element>& lhs, const std::vector<Element>& rhs, const std::string& name) {
+    std::vector<Element> expected{};
+    std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(expected));
+    const bool expected_empty{ expected.empty() };
+    const Unaligned lhs_data{ lhs }, rhs_data{ rhs };
+
+    // One spare element after the result, to detect writes past the largest possible result.
+    constexpr Element CANARY{ 0x5eed };
+    std::vector<Element> result(lhs.size() + 1, CANARY);
+    result.resize(simd::intersection(lhs_data.data(), lhs.size(), rhs_data.data(), rhs.size(), result.data()));
+    test::check(result == expected, name + ": intersection");
+
+    expected.clear();
+    std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(expected));
+    result.assign(lhs.size() + 1, CANARY);
+    const size_t difference_size{ simd::difference(lhs_data.data(), lhs.size(), rhs_data.data(), rhs.size(),
+                                                   result.data()) };
+    test::check(result[lhs.size()] == CANARY, name + ": difference writes past the result");
+    result.resize(difference_size);
+    test::check(result == expected, name + ": difference");
+
+    test::check(simd::is_intersection_empty(lhs_data.data(), lhs.size(), rhs_data.data(), rhs.size())
+                == expected_empty, name + ": is_intersection_empty");
+    test::check(simd::is_subset_of(lhs_data.data(), lhs.size(), rhs_data.data(), rhs.size())
+                == std::includes(rhs.begin(), rhs.end(), lhs.begin(), lhs.end()), name + ": is_subset_of");
+
+    // The same through OrdVector, which dispatches to the kernels.
+    const OrdVector<Element> lhs_set{ lhs }, rhs_set{ rhs };
+    std::vector<Element> united{};
+    std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(united));
+    OrdVector<Element> merged{ lhs_set };
+    merged.insert(rhs_set);
+    test::check(merged.to_vector() == united, name + ": OrdVector::insert");
+    test::check(OrdVector<Element>::set_union(lhs_set, rhs_set).to_vector() == united, name + ": OrdVector::set_union");
+    test::check(lhs_set.difference(rhs_set).to_vector() == expected, name + ": OrdVector::difference");
+}
+
+/// Pairs of sets of the given sizes: independent, equal, nested, disjoint and interleaved.
+size_t check_sizes(test::Random& random, const size_t lhs_size, const size_t rhs_size) {
+    size_t num_of_cases{ 0 };
+    const auto check = [&](const std::vector<Element>& lhs, const std::vector<Element>& rhs, const char* kind) {
+        for (const Element base : BASES) {
+            check_operations(shifted(lhs, base), shifted(rhs, base),
+                             std::string{ kind } + " " + std::to_string(lhs.size()) + "/" + std::to_string(rhs.size())
+                             + " from " + std::to_string(base));
+            ++num_of_cases;
+        }
+    };
+
+    // Dense universe: many common elements. Sparse universe: few common elements.
+    const size_t max_size{ std::max(lhs_size, rhs_size) };
+    check(test::random_set(random, lhs_size, 2 * max_size + 1), test::random_set(random, rhs_size, 2 * max_size + 1),
+          "dense");
+    check(test::random_set(random, lhs_size, 1000), test::random_set(random, rhs_size, 1000), "sparse");
+
+    const std::vector<Element> set{ test::random_set(random, max_size, 3 * max_size + 1) };
+    check(set, set, "equal");
+    const std::vector<Element> prefix(set.begin(), set.begin() + static_cast<long>(std::min(lhs_size, rhs_size)));
+    check(prefix, set, "prefix");
+    check(set, prefix, "superset");
+
+    std::vector<Element> subset{};
+    std::copy_if(set.begin(), set.end(), std::back_inserter(subset), [&](Element) { return test::below(random, 2); });
+    check(subset, set, "subset");
+
+    std::vector<Element> even{}, odd{};
+    for (Element i{ 0 }; i < lhs_size; ++i) { even.push_back(2 * i); }
+    for (Element i{ 0 }; i < rhs_size; ++i) { odd.push_back(2 * i + 1); }
+    check(even, odd, "interleaved");
+    std::vector<Element> above{ odd };
+    for (Element& element : above) { element += 2 * lhs_size; }
+    check(even, above, "disjoint");
+    return num_of_cases;
+}
+
+} // namespace.
+
+int main() {
+    size_t num_of_cases{ 0 };
+    for (const simd::InstructionSet instruction_set :
+         { simd::InstructionSet::Scalar, simd::InstructionSet::Sse41, simd::InstructionSet::Avx2 }) {
+        if (!simd::set_instruction_set(instruction_set)) {
+            std::printf("%s is not supported, skipped\n", simd::to_string(instruction_set));
+            continue;
+        }
+        test::Random random{ 2024 };
+        for (const size_t lhs_size : SIZES) {
+            for (const size_t rhs_size : SIZES) { num_of_cases += check_sizes(random, lhs_size, rhs_size); }
+        }
+        for (size_t i{ 0 }; i < 100; ++i) {
+            num_of_cases += check_sizes(random, test::below(random, 300), test::below(random, 300));
+        }
+    }
+    return test::finish("set-ops", num_of_cases);
+}
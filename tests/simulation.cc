@@ -0,0 +1,187 @@
+// Simulations of automata compared with a naive simulation over std::set: set-based, frozen, bit-parallel, lazily
+//  determinized and mapped from the binary format after a round trip through a file.
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "test.hh"
+#include "mata/nfa/generator.hh"
+#include "mata/nfa/lazy-dfa.hh"
+#include "mata/nfa/serialization.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+/// Extend @p states by the states reachable over epsilon transitions.
+void reference_closure(const Nfa& nfa, std::set<State>& states) {
+    std::vector<State> worklist(states.begin(), states.end());
+    while (!worklist.empty()) {
+        const State state{ worklist.back() };
+        worklist.pop_back();
+        if (state >= nfa.delta.numStates()) { continue; }
+        for (const SymbolPost& symbol_post : nfa.delta.getStatePost(state)) {
+            if (symbol_post.symbol != EPSILON) { continue; }
+            for (const Target& target : symbol_post.targets) {
+                if (states.insert(target.state).second) { worklist.push_back(target.state); }
+            }
+        }
+    }
+}
+
+/// Naive simulation ignoring the counters.
+bool reference_simulate(const Nfa& nfa, const std::string& input) {
+    std::set<State> states(nfa.initial.begin(), nfa.initial.end());
+    reference_closure(nfa, states);
+    for (const char c : input) {
+        std::set<State> successors{};
+        for (const State state : states) {
+            if (state >= nfa.delta.numStates()) { continue; }
+            for (const SymbolPost& symbol_post : nfa.delta.getStatePost(state)) {
+                // A NUL byte is the symbol EPSILON, which matches no transition.
+                if (symbol_post.symbol != toSymbol(c) || symbol_post.symbol == EPSILON) { continue; }
+                for (const Target& target : symbol_post.targets) { successors.insert(target.state); }
+            }
+        }
+        states = std::move(successors);
+        reference_closure(nfa, states);
+    }
+    for (const State state : states) {
+        if (nfa.final.contains(state)) { return true; }
+    }
+    return false;
+}
+
+/// Annotation as (opcode, counter ID, operand, upper bound), which can be ordered.
+using AnnotationRecord = std::tuple<Annotation::Opcode, uint32_t, CounterValue, CounterValue>;
+/// Transitions with the annotations of their targets, as (source, symbol, target, annotations).
+using AnnotatedTransitions = std::set<std::tuple<State, Symbol, State, std::vector<AnnotationRecord>>>;
+
+AnnotatedTransitions annotated_transitions(const Nfa& nfa) {
+    AnnotatedTransitions transitions{};
+    for (State source{ 0 }; source < nfa.delta.numStates(); ++source) {
+        for (const SymbolPost& symbol_post : nfa.delta.getStatePost(source)) {
+            for (const Target& target : symbol_post.targets) {
+                std::vector<AnnotationRecord> annotations{};
+                if (target.annotation_id != UNDEFINED_ID) {
+                    for (const Annotation& annotation : nfa.theta[target.annotation_id]) {
+                        annotations.emplace_back(annotation.opcode, annotation.counter_id, annotation.operand,
+                                                 annotation.upper);
+                    }
+                }
+                transitions.emplace(source, symbol_post.symbol, target.state, std::move(annotations));
+            }
+        }
+    }
+    return transitions;
+}
+
+bool equal_states(const mata::utils::SparseSet<State>& states, const std::span<const State> sorted_states) {
+    const std::set<State> set(states.begin(), states.end());
+    return std::equal(set.begin(), set.end(), sorted_states.begin(), sorted_states.end());
+}
+
+/// Check that @p mapped_nfa, saved from @p nfa, has the same states, transitions, annotations and counters.
+void check_round_trip(const Nfa& nfa, const MappedNfa& mapped_nfa, const std::string& name) {
+    test::check(equal_states(nfa.initial, mapped_nfa.initial()), name + ": initial states");
+    test::check(equal_states(nfa.final, mapped_nfa.final()), name + ": final states");
+    const Nfa loaded_nfa{ mapped_nfa.toNfa() };
+    test::check(annotated_transitions(loaded_nfa) == annotated_transitions(nfa), name + ": transitions");
+    test::check(loaded_nfa.counters.size() == nfa.counters.size(), name + ": number of counters");
+    for (size_t counter{ 0 }; counter < std::min(nfa.counters.size(), loaded_nfa.counters.size()); ++counter) {
+        test::check(loaded_nfa.counters[counter].initial_value == nfa.counters[counter].initial_value,
+                    name + ": initial values of the counters");
+    }
+}
+
+/// Compare all simulations of @p nfa with the reference on @p words.
+void check_simulations(const Nfa& nfa, const std::vector<std::string>& words, const std::string& path,
+                       const std::string& name) {
+    Nfa frozen_nfa{ nfa };
+    frozen_nfa.freeze(false);
+    Nfa bit_parallel_nfa{ nfa };
+    bit_parallel_nfa.freeze();
+    // A small memory budget makes the lazy DFA flush its cache in the middle of words.
+    LazyDfa lazy_dfa{ nfa, 4096 };
+    saveNfa(nfa, path);
+    const MappedNfa mapped_nfa{ path };
+    check_round_trip(nfa, mapped_nfa, name);
+
+    for (const std::string& word : words) {
+        const bool expected{ reference_simulate(nfa, word) };
+        const std::string on_word{ " on \"" + word + "\"" };
+        test::check(nfa.simulate(word) == expected, name + ": simulate" + on_word);
+        test::check(frozen_nfa.simulate(word) == expected, name + ": frozen simulate" + on_word);
+        test::check(bit_parallel_nfa.simulate(word) == expected, name + ": bit-parallel simulate" + on_word);
+        test::check(lazy_dfa.simulate(word) == expected, name + ": lazy DFA" + on_word);
+        test::check(mapped_nfa.simulate(word) == expected, name + ": mapped simulate" + on_word);
+    }
+}
+
+} // namespace.
+
+int main() {
+    const std::string path{ (std::filesystem::temp_directory_path() / "mata-test-simulation.nfa").string() };
+    test::Random random{ 2024 };
+    size_t num_of_cases{ 0 };
+
+    // Automata without transitions, with no initial states and with states only in the initial or final states.
+    Nfa empty_nfa{};
+    check_simulations(empty_nfa, { "", "a" }, path, "empty automaton");
+    Nfa isolated_nfa{};
+    isolated_nfa.addInitialState(3);
+    isolated_nfa.addFinalState(3);
+    check_simulations(isolated_nfa, { "", "a" }, path, "isolated state");
+    // NUL bytes of the input must not follow epsilon transitions.
+    Nfa epsilon_nfa{};
+    epsilon_nfa.delta = Delta{ 3 };
+    epsilon_nfa.delta.add(0, EPSILON, 1);
+    epsilon_nfa.delta.add(1, 'a', 2);
+    epsilon_nfa.delta.add(2, EPSILON, 0);
+    epsilon_nfa.addInitialState(0);
+    epsilon_nfa.addFinalState(1);
+    check_simulations(epsilon_nfa, { "", "a", std::string(1, '\0'), std::string{ "a\0", 2 },
+                                     std::string{ "\0a", 2 } }, path, "epsilon transitions with NUL input");
+    num_of_cases += 3;
+
+    // Sizes around the limits of the bit-parallel deltas (64, 128 and 256 states) and beyond.
+    for (const size_t num_of_states : { 1, 2, 5, 63, 64, 65, 128, 129, 256, 257, 1000 }) {
+        for (uint64_t seed{ 0 }; seed < 10; ++seed) {
+            GeneratorParameters parameters{};
+            parameters.seed = seed;
+            parameters.num_of_states = num_of_states;
+            parameters.alphabet_size = 2 + seed % 3;
+            parameters.out_degree = seed % 2 == 0 ? 1.5 : 3.0;
+            parameters.distribution = seed % 4 < 2 ? DegreeDistribution::Uniform : DegreeDistribution::PowerLaw;
+            parameters.epsilon_density = seed % 3 == 0 ? 0.0 : 0.2;
+            parameters.final_density = 0.05;
+            parameters.num_of_counters = seed % 2;
+            parameters.annotation_density = 0.2;
+            const Nfa nfa{ generateNfa(parameters) };
+
+            std::vector<std::string> words{ "" };
+            for (size_t length{ 1 }; length <= 40; length += 3) {
+                words.push_back(test::random_word(random, length, parameters.alphabet_size));
+            }
+            CorpusParameters corpus_parameters{};
+            corpus_parameters.seed = seed;
+            corpus_parameters.num_of_words = 5;
+            corpus_parameters.length = 20;
+            corpus_parameters.alphabet_size = parameters.alphabet_size;
+            for (const std::string& word : generateNonMatchingWords(nfa, corpus_parameters)) { words.push_back(word); }
+            std::string word_with_nul{ test::random_word(random, 10, parameters.alphabet_size) };
+            word_with_nul[test::below(random, word_with_nul.size())] = '\0';
+            words.push_back(word_with_nul);
+            check_simulations(nfa, words, path, std::to_string(num_of_states) + " states, seed "
+                                                + std::to_string(seed));
+            ++num_of_cases;
+        }
+    }
+    std::remove(path.c_str());
+    return test::finish("simulation", num_of_cases);
+}
@@ -0,0 +1,155 @@
+// SmallVector (mata/utils/small-vector.hh) compared with std::vector on random sequences of operations, and
+//  SmallOrdVector compared with std::set.
+
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test.hh"
+#include "mata/utils/ord-vector.hh"
+#include "mata/utils/small-vector.hh"
+
+using namespace mata::utils;
+
+namespace {
+
+std::string make_value(const uint64_t number) {
+    // Long enough not to fit into the small string buffer, so that lost or doubled objects are detected by ASan.
+    return "value number " + std::to_string(number) + " of the small vector test";
+}
+
+template<class Vector>
+bool equal(const Vector& vector, const std::vector<std::string>& reference) {
+    return vector.size() == reference.size() && std::equal(vector.begin(), vector.end(), reference.begin())
+           && vector.capacity() >= vector.size() && vector.capacity() >= Vector::inline_capacity();
+}
+
+/// Apply @p num_of_operations random operations to a @p Vector and to a std::vector and compare them after each one.
+template<class Vector>
+void check_operations(test::Random& random, const size_t num_of_operations, Vector vector, const std::string& name) {
+    std::vector<std::string> reference{};
+    for (size_t i{ 0 }; i < num_of_operations; ++i) {
+        const std::string value{ make_value(test::below(random, 1000)) };
+        const size_t position{ test::below(random, reference.size() + 1) };
+        const size_t operation{ test::below(random, 14) };
+        switch (operation) {
+            case 0: case 1: vector.push_back(value); reference.push_back(value); break;
+            case 2:
+                if (!reference.empty()) { vector.pop_back(); reference.pop_back(); }
+                break;
+            case 3:
+                vector.insert(vector.begin() + position, value);
+                reference.insert(reference.begin() + static_cast<long>(position), value);
+                break;
+            case 4: {
+                // Elements of the vector itself, which may be moved by the insertion.
+                if (reference.empty()) { break; }
+                const size_t source{ test::below(random, reference.size()) };
+                vector.insert(vector.begin() + position, vector[source]);
+                reference.insert(reference.begin() + static_cast<long>(position), reference[source]);
+                break;
+            }
+            case 5:
+                if (!reference.empty()) {
+                    vector.push_back(vector.front());
+                    reference.push_back(reference.front());
+                }
+                break;
+            case 6: {
+                std::vector<std::string> values(test::below(random, 6));
+                for (std::string& inserted : values) { inserted = make_value(test::below(random, 1000)); }
+                vector.insert(vector.begin() + position, values.begin(), values.end());
+                reference.insert(reference.begin() + static_cast<long>(position), values.begin(), values.end());
+                break;
+            }
+            case 7: {
+                const size_t last{ position + test::below(random, reference.size() - position + 1) };
+                vector.erase(vector.begin() + position, vector.begin() + last);
+                reference.erase(reference.begin() + static_cast<long>(position),
+                                reference.begin() + static_cast<long>(last));
+                break;
+            }
+            case 8: {
+                const size_t new_size{ test::below(random, 2 * reference.size() + 3) };
+                vector.resize(new_size, value);
+                reference.resize(new_size, value);
+                break;
+            }
+            case 9: {
+                const size_t new_size{ test::below(random, 2 * reference.size() + 3) };
+                vector.resize(new_size);
+                reference.resize(new_size);
+                break;
+            }
+            case 10: vector.reserve(test::below(random, 2 * reference.size() + 3)); break;
+            case 11: vector.shrink_to_fit(); break;
+            case 12: {
+                // Copies and moves between inline and heap storage.
+                Vector copy{ vector };
+                test::check(equal(copy, reference), name + ": copy");
+                Vector moved{ std::move(copy) };
+                vector = moved;
+                test::check(equal(vector, reference), name + ": copy assignment");
+                Vector other{ vector.get_allocator() };
+                other.push_back(value);
+                other = std::move(moved);
+                vector = std::move(other);
+                break;
+            }
+            default:
+                if (test::below(random, 8) == 0) { vector.clear(); reference.clear(); }
+                break;
+        }
+        if (!test::check(equal(vector, reference), name + ": operation " + std::to_string(operation) + " at step "
+                                                  + std::to_string(i))) {
+            return;
+        }
+    }
+}
+
+/// Insert random numbers into a SmallOrdVector and a std::set, one by one and merged as sets.
+void check_ord_vector(test::Random& random, const size_t num_of_operations) {
+    SmallOrdVector<uint64_t, 2> set{};
+    std::set<uint64_t> reference{};
+    for (size_t i{ 0 }; i < num_of_operations; ++i) {
+        const uint64_t universe{ 1 + test::below(random, 64) };
+        if (test::below(random, 3) == 0) {
+            const std::vector<uint64_t> values{ test::random_set(random, test::below(random, 8), universe) };
+            set.insert(SmallOrdVector<uint64_t, 2>{ values });
+            reference.insert(values.begin(), values.end());
+        } else if (test::below(random, 4) == 0) {
+            const uint64_t value{ test::below(random, universe) };
+            set.erase(value);
+            reference.erase(value);
+        } else {
+            const uint64_t value{ test::below(random, universe) };
+            set.insert(value);
+            reference.insert(value);
+        }
+        if (!test::check(std::equal(set.begin(), set.end(), reference.begin(), reference.end()),
+                         "SmallOrdVector: step " + std::to_string(i))) {
+            return;
+        }
+    }
+}
+
+} // namespace.
+
+int main() {
+    constexpr size_t NUM_OF_RUNS{ 200 };
+    test::Random random{ 2024 };
+    std::pmr::monotonic_buffer_resource arena{};
+    for (size_t run{ 0 }; run < NUM_OF_RUNS; ++run) {
+        // Short runs stay mostly inline, long runs mostly on the heap.
+        const size_t num_of_operations{ run % 2 == 0 ? size_t{ 20 } : size_t{ 500 } };
+        check_operations(random, num_of_operations, SmallVector<std::string, 1>{}, "SmallVector<string, 1>");
+        check_operations(random, num_of_operations, SmallVector<std::string, 4>{}, "SmallVector<string, 4>");
+        check_operations(random, num_of_operations,
+                         SmallVector<std::string, 2, std::pmr::polymorphic_allocator<std::string>>{ &arena },
+                         "SmallVector<string, 2> in an arena");
+        check_ord_vector(random, num_of_operations);
+    }
+    return test::finish("small-vector", 4 * NUM_OF_RUNS);
+}
@@ -0,0 +1,70 @@
+// Small helpers shared by the tests.
+//
+// The tests compare the optimized code with simple reference implementations (the scalar code or the standard
+//  library) on random inputs from a fixed seed, so that a failure can be reproduced by running the test again.
+
+#ifndef TEST_HH
+#define TEST_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace test {
+
+/// Random numbers from a fixed seed, the same on every run.
+using Random = std::mt19937_64;
+
+/// Uniformly random number in [0, @p bound).
+inline uint64_t below(Random& random, const uint64_t bound) {
+    return std::uniform_int_distribution<uint64_t>{ 0, bound - 1 }(random);
+}
+
+/// Sorted vector of @p size unique random numbers below @p universe (at most @p universe of them).
+inline std::vector<uint64_t> random_set(Random& random, const size_t size, const uint64_t universe) {
+    std::set<uint64_t> set{};
+    while (set.size() < std::min<uint64_t>(size, universe)) { set.insert(below(random, universe)); }
+    return { set.begin(), set.end() };
+}
+
+/// Random word of @p length symbols from @p first_symbol, ..., @p first_symbol + @p alphabet_size - 1.
+inline std::string random_word(Random& random, const size_t length, const size_t alphabet_size = 2,
+                               const char first_symbol = 'a') {
+    std::string word(length, first_symbol);
+    for (char& c : word) { c = static_cast<char>(first_symbol + static_cast<char>(below(random, alphabet_size))); }
+    return word;
+}
+
+/// Failed checks of the running test.
+inline size_t& failures() {
+    static size_t failures{ 0 };
+    return failures;
+}
+
+/// Record a failure described by @p message unless @p condition holds. Only the first failures are printed.
+inline bool check(const bool condition, const std::string& message) {
+    if (!condition) {
+        constexpr size_t MAX_PRINTED_FAILURES{ 10 };
+        if (failures() < MAX_PRINTED_FAILURES) { std::printf("FAILED: %s\n", message.c_str()); }
+        ++failures();
+    }
+    return condition;
+}
+
+/// Print the result of the test @p name with @p num_of_cases random cases and return the exit code of the test.
+inline int finish(const char* const name, const size_t num_of_cases) {
+    if (failures() == 0) {
+        std::printf("%-32s %8zu cases passed\n", name, num_of_cases);
+        return 0;
+    }
+    std::printf("%-32s %8zu checks failed\n", name, failures());
+    return 1;
+}
+
+} // namespace test.
+
+#endif // TEST_HH